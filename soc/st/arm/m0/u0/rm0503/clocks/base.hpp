@@ -10,6 +10,46 @@
 // std
 #include <cstdint>
 
+// xmcu
+#include <xmcu/non_constructible.hpp>
+
 namespace soc::st::arm::m0::u0::rm0503::clocks::details {
 constexpr inline static std::uint32_t shift_lut[] = { 1u, 2u, 4u, 8u, 16u, 32u, 64u, 128u, 512u };
+// indexed with CFGR.HPRE
+constexpr inline static std::uint32_t hpre_shift_lut[] = { 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 1u, 2u, 3u, 4u, 6u, 7u, 8u, 9u };
+// indexed with CFGR.PPRE
+constexpr inline static std::uint32_t ppre_shift_lut[] = { 0u, 0u, 0u, 0u, 1u, 2u, 3u, 4u };
+
+// RCC is walked once after a clock tree change, getters return cached values afterwards
+// values are double buffered: the published entry is never written, so it can be read at any time (NMI included)
+struct frequency_cache : private xmcu::non_constructible
+{
+    struct Entry
+    {
+        std::uint32_t sysclk_Hz = 0u;
+        std::uint32_t hclk_Hz = 0u;
+        std::uint32_t pclk_Hz = 0u;
+    };
+
+    // generation lets update() detect an invalidate() from an interrupt (NMI) it can't mask
+    static void invalidate()
+    {
+        generation = generation + 1u;
+        valid = false;
+    }
+
+    // defined in sysclk.hpp
+    static void update();
+
+    [[nodiscard]] static const Entry& get()
+    {
+        return entries[published];
+    }
+
+    inline static volatile bool valid = false;
+    inline static volatile std::uint32_t generation = 0u;
+    inline static volatile std::uint32_t published = 0u;
+    inline static Entry entries[2] = { { .sysclk_Hz = 0u, .hclk_Hz = 0u, .pclk_Hz = 0u },
+                                       { .sysclk_Hz = 0u, .hclk_Hz = 0u, .pclk_Hz = 0u } };
+};
 }
\ No newline at end of file
@@ -0,0 +1,368 @@
+#pragma once
+
+/*
+ *	Name: clock_tree.hpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+// std
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// xmcu
+#include <xmcu/non_constructible.hpp>
+
+// soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/hclk.hpp>
+#include <soc/st/arm/m0/u0/rm0503/clocks/pclk.hpp>
+#include <soc/st/arm/m0/u0/rm0503/clocks/sysclk.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/hse.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/hsi16.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/msi.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/pll.hpp>
+#include <soc/st/arm/m0/u0/rm0503/peripherals/INTERNAL_FLASH/internal_flash.hpp>
+#include <soc/st/arm/m0/u0/rm0503/peripherals/POWER/pwr.hpp>
+
+namespace soc::st::arm::m0::u0::rm0503::clocks {
+struct clock_tree : private xmcu::non_constructible
+{
+    struct Descriptor
+    {
+        std::uint32_t source_Hz = 0u;
+        std::uint32_t sysclk_Hz = 0u;
+        std::uint32_t hclk_Hz = 0u;
+        std::uint32_t pclk_Hz = 0u;
+
+        // 0 - output not used
+        std::uint32_t pll_p_Hz = 0u;
+        std::uint32_t pll_q_Hz = 0u;
+    };
+
+    struct limits : private xmcu::non_constructible
+    {
+        constexpr static std::uint32_t sysclk_max_Hz = 56'000'000u;
+        constexpr static std::uint32_t pll_input_min_Hz = 2'660'000u;
+        constexpr static std::uint32_t pll_input_max_Hz = 16'000'000u;
+        constexpr static std::uint32_t pll_vco_min_Hz = 96'000'000u;
+        constexpr static std::uint32_t pll_vco_max_Hz = 344'000'000u;
+        constexpr static std::uint32_t pll_p_max_Hz = 122'000'000u;
+        constexpr static std::uint32_t pll_q_max_Hz = 128'000'000u;
+    };
+
+    template<typename source_t, Descriptor descriptor_t> struct Plan : private xmcu::non_constructible
+    {
+        static_assert(std::is_same_v<source_t, oscillators::hsi16> || std::is_same_v<source_t, oscillators::msi> ||
+                          std::is_same_v<source_t, oscillators::hse>,
+                      "clock tree source has to be hsi16, msi or hse");
+        static_assert(false == std::is_same_v<source_t, oscillators::hsi16> ||
+                      oscillators::hsi16::get_frequency_Hz() == descriptor_t.source_Hz);
+        static_assert(descriptor_t.sysclk_Hz > 0u && descriptor_t.sysclk_Hz <= limits::sysclk_max_Hz);
+
+    private:
+        // MSI run range matching source_Hz, programmed by start_source()
+        constexpr static auto get_msi_range = []() -> std::pair<bool, oscillators::msi::Run::Frequency> {
+            using enum oscillators::msi::Run::Frequency;
+
+            switch (descriptor_t.source_Hz)
+            {
+                case 100'000u:
+                    return { true, _100_kHz };
+                case 200'000u:
+                    return { true, _200_kHz };
+                case 400'000u:
+                    return { true, _400_kHz };
+                case 800'000u:
+                    return { true, _800_kHz };
+                case 1'000'000u:
+                    return { true, _1_MHz };
+                case 2'000'000u:
+                    return { true, _2_MHz };
+                case 4'000'000u:
+                    return { true, _4_MHz };
+                case 8'000'000u:
+                    return { true, _8_MHz };
+                case 16'000'000u:
+                    return { true, _16_MHz };
+                case 24'000'000u:
+                    return { true, _24_MHz };
+                case 32'000'000u:
+                    return { true, _32_MHz };
+                case 48'000'000u:
+                    return { true, _48_MHz };
+            }
+
+            return { false, _4_MHz };
+        };
+
+        static_assert(false == std::is_same_v<source_t, oscillators::msi> || true == get_msi_range().first,
+                      "source_Hz is not an MSI range");
+
+        struct Pll
+        {
+            bool found = false;
+            std::uint32_t m = 0u;
+            std::uint32_t n = 0u;
+            std::uint32_t r = 0u;
+            std::uint32_t p = 0u;
+            std::uint32_t q = 0u;
+            std::uint32_t vco_Hz = 0u;
+        };
+
+        // divider producing exactly output_Hz_a from vco_Hz_a, 0 if there is none in range
+        constexpr static auto get_divider =
+            [](std::uint32_t vco_Hz_a, std::uint32_t output_Hz_a, std::uint32_t min_a, std::uint32_t max_a) {
+                if (0u == output_Hz_a || 0u != vco_Hz_a % output_Hz_a)
+                {
+                    return 0u;
+                }
+
+                const std::uint32_t divider = vco_Hz_a / output_Hz_a;
+                return (divider >= min_a && divider <= max_a) ? divider : 0u;
+            };
+
+        // lowest VCO frequency meeting all requested outputs
+        constexpr static Pll pll = []() {
+            Pll ret;
+
+            for (std::uint32_t m = 1u; m <= 8u; m++)
+            {
+                if (0u != descriptor_t.source_Hz % m || descriptor_t.source_Hz / m < limits::pll_input_min_Hz ||
+                    descriptor_t.source_Hz / m > limits::pll_input_max_Hz)
+                {
+                    continue;
+                }
+
+                for (std::uint32_t n = 4u; n <= 127u; n++)
+                {
+                    const std::uint64_t vco_Hz = static_cast<std::uint64_t>(descriptor_t.source_Hz / m) * n;
+
+                    if (vco_Hz < limits::pll_vco_min_Hz || vco_Hz > limits::pll_vco_max_Hz || (true == ret.found && vco_Hz >= ret.vco_Hz))
+                    {
+                        continue;
+                    }
+
+                    const std::uint32_t r = get_divider(static_cast<std::uint32_t>(vco_Hz), descriptor_t.sysclk_Hz, 2u, 8u);
+                    const std::uint32_t p = get_divider(static_cast<std::uint32_t>(vco_Hz), descriptor_t.pll_p_Hz, 2u, 32u);
+                    const std::uint32_t q = get_divider(static_cast<std::uint32_t>(vco_Hz), descriptor_t.pll_q_Hz, 2u, 8u);
+
+                    if (0u != r && (0u == descriptor_t.pll_p_Hz || 0u != p) && (0u == descriptor_t.pll_q_Hz || 0u != q))
+                    {
+                        ret = { .found = true, .m = m, .n = n, .r = r, .p = p, .q = q, .vco_Hz = static_cast<std::uint32_t>(vco_Hz) };
+                    }
+                }
+            }
+
+            return ret;
+        }();
+
+    public:
+        using Source = source_t;
+
+        constexpr static bool uses_pll =
+            descriptor_t.sysclk_Hz != descriptor_t.source_Hz || 0u != descriptor_t.pll_p_Hz || 0u != descriptor_t.pll_q_Hz;
+
+        static_assert(false == uses_pll || true == pll.found, "no PLL configuration produces requested frequencies");
+        static_assert(false == uses_pll || (pll.vco_Hz >= limits::pll_vco_min_Hz && pll.vco_Hz <= limits::pll_vco_max_Hz));
+        static_assert(descriptor_t.pll_p_Hz <= limits::pll_p_max_Hz && descriptor_t.pll_q_Hz <= limits::pll_q_max_Hz);
+
+        constexpr static std::uint32_t source_frequency_Hz = descriptor_t.source_Hz;
+        constexpr static std::uint32_t sysclk_frequency_Hz = descriptor_t.sysclk_Hz;
+        constexpr static std::uint32_t hclk_frequency_Hz = descriptor_t.hclk_Hz;
+        constexpr static std::uint32_t pclk_frequency_Hz = descriptor_t.pclk_Hz;
+        constexpr static std::uint32_t pll_vco_frequency_Hz = true == uses_pll ? pll.vco_Hz : 0u;
+        constexpr static std::uint32_t pll_p_frequency_Hz = descriptor_t.pll_p_Hz;
+        constexpr static std::uint32_t pll_q_frequency_Hz = descriptor_t.pll_q_Hz;
+
+        constexpr static std::uint32_t pll_m = pll.m;
+        constexpr static std::uint32_t pll_n = pll.n;
+        constexpr static std::uint32_t pll_r = pll.r;
+        constexpr static std::uint32_t pll_p = pll.p;
+        constexpr static std::uint32_t pll_q = pll.q;
+
+        static_assert(0u != descriptor_t.hclk_Hz && 0u == descriptor_t.sysclk_Hz % descriptor_t.hclk_Hz);
+        static_assert(0u != descriptor_t.pclk_Hz && 0u == descriptor_t.hclk_Hz % descriptor_t.pclk_Hz);
+        static_assert(std::has_single_bit(descriptor_t.sysclk_Hz / descriptor_t.hclk_Hz) &&
+                          32u != descriptor_t.sysclk_Hz / descriptor_t.hclk_Hz && descriptor_t.sysclk_Hz / descriptor_t.hclk_Hz <= 512u,
+                      "unsupported hclk prescaler");
+        static_assert(std::has_single_bit(descriptor_t.hclk_Hz / descriptor_t.pclk_Hz) &&
+                          descriptor_t.hclk_Hz / descriptor_t.pclk_Hz <= 16u,
+                      "unsupported pclk prescaler");
+
+        constexpr static hclk::Descriptor::Prescaler hclk_prescaler = []() {
+            switch (descriptor_t.sysclk_Hz / descriptor_t.hclk_Hz)
+            {
+                case 1u:
+                    return hclk::Descriptor::Prescaler::_1;
+                case 2u:
+                    return hclk::Descriptor::Prescaler::_2;
+                case 4u:
+                    return hclk::Descriptor::Prescaler::_4;
+                case 8u:
+                    return hclk::Descriptor::Prescaler::_8;
+                case 16u:
+                    return hclk::Descriptor::Prescaler::_16;
+                case 64u:
+                    return hclk::Descriptor::Prescaler::_64;
+                case 128u:
+                    return hclk::Descriptor::Prescaler::_128;
+                case 256u:
+                    return hclk::Descriptor::Prescaler::_256;
+            }
+
+            return hclk::Descriptor::Prescaler::_512;
+        }();
+        constexpr static pclk::Descriptor::Prescaler pclk_prescaler = []() {
+            switch (descriptor_t.hclk_Hz / descriptor_t.pclk_Hz)
+            {
+                case 1u:
+                    return pclk::Descriptor::Prescaler::_1;
+                case 2u:
+                    return pclk::Descriptor::Prescaler::_2;
+                case 4u:
+                    return pclk::Descriptor::Prescaler::_4;
+                case 8u:
+                    return pclk::Descriptor::Prescaler::_8;
+            }
+
+            return pclk::Descriptor::Prescaler::_16;
+        }();
+
+        // SYSCLK above 16 MHz and the PLL run only in voltage range 1, the range is never lowered here
+        constexpr static bool needs_voltage_range_1 = true == uses_pll || descriptor_t.sysclk_Hz > 16'000'000u;
+
+        // source -> (sysclk off PLL -> PLL off -> PLL config -> PLL on) -> prescalers -> sysclk switch
+        static void apply()
+        {
+            start_source();
+            while (false == source_t::is_ready()) continue;
+
+            if constexpr (true == uses_pll)
+            {
+                start_pll();
+                while (false == oscillators::pll::is_ready()) continue;
+            }
+
+            switch_sysclk();
+        }
+
+        // steps of apply() for callers which can't block on the ready flags
+        // MSI range is switched in place when MSI already runs, SYSCLK follows it right away if it's on MSI
+        static void start_source()
+        {
+            if constexpr (true == std::is_same_v<source_t, oscillators::hse>)
+            {
+                if (false == oscillators::hse::is_enabled())
+                {
+                    oscillators::hse::enable(descriptor_t.source_Hz);
+                }
+            }
+            else if constexpr (true == std::is_same_v<source_t, oscillators::msi>)
+            {
+                if (false == oscillators::msi::run.is_active() || get_msi_range().second != oscillators::msi::run.get_frequency())
+                {
+                    oscillators::msi::run.set_frequency(get_msi_range().second);
+                    oscillators::msi::run.set_active();
+                }
+                if (false == oscillators::msi::is_enabled())
+                {
+                    oscillators::msi::enable();
+                }
+
+                assert(descriptor_t.source_Hz == oscillators::msi::get_frequency_Hz());
+            }
+            else
+            {
+                if (false == source_t::is_enabled())
+                {
+                    source_t::enable();
+                }
+            }
+        }
+        // source has to be ready
+        static void start_pll()
+        {
+            static_assert(true == uses_pll);
+            assert(true == source_t::is_ready());
+
+            set_voltage_range_1();
+
+            if (true == sysclk::is_trait<sysclk::traits::source<oscillators::pll::R>>())
+            {
+                sysclk::set_traits<sysclk::traits::source<source_t>>();
+            }
+            if (true == oscillators::pll::is_enabled())
+            {
+                oscillators::pll::disable();
+                while (true == oscillators::pll::is_ready()) continue;
+            }
+
+            oscillators::pll::set_traits<oscillators::pll::traits::source<source_t>>();
+            oscillators::pll::set_descriptor({ .m = pll.m, .n = pll.n });
+
+            oscillators::pll::r.set_descriptor({ .divider = pll.r });
+            oscillators::pll::r.enable();
+
+            if constexpr (0u != pll.p)
+            {
+                oscillators::pll::p.set_descriptor({ .divider = pll.p });
+                oscillators::pll::p.enable();
+            }
+            else
+            {
+                oscillators::pll::p.disable();
+            }
+            if constexpr (0u != pll.q)
+            {
+                oscillators::pll::q.set_descriptor({ .divider = pll.q });
+                oscillators::pll::q.enable();
+            }
+            else
+            {
+                oscillators::pll::q.disable();
+            }
+
+            oscillators::pll::enable();
+        }
+        // source (and PLL) has to be ready
+        static void switch_sysclk()
+        {
+            if constexpr (true == needs_voltage_range_1)
+            {
+                set_voltage_range_1();
+            }
+
+            hclk::set_descriptor({ .prescaler = hclk_prescaler });
+            pclk::set_descriptor({ .prescaler = pclk_prescaler });
+
+            if constexpr (true == uses_pll)
+            {
+                assert(true == oscillators::pll::is_ready());
+                sysclk::set_traits<sysclk::traits::source<oscillators::pll::R>>();
+            }
+            else
+            {
+                assert(true == source_t::is_ready());
+                sysclk::set_traits<sysclk::traits::source<source_t>>();
+            }
+        }
+
+    private:
+        static void set_voltage_range_1()
+        {
+            peripherals::pwr::clock::enable();
+
+            if (peripherals::pwr::Voltage_scaling::range_2 == peripherals::pwr::get_voltage_scaling())
+            {
+                peripherals::pwr::set_voltage_scaling(peripherals::pwr::Voltage_scaling::range_1);
+            }
+
+            peripherals::pwr::clock::disable();
+        }
+    };
+};
+} // namespace soc::st::arm::m0::u0::rm0503::clocks
@@ -0,0 +1,238 @@
+#pragma once
+
+/*
+ *	Name: frequency_scaling.hpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+// std
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+// CMSIS
+#include <stm32u0xx.h>
+
+// xmcu
+#include <xmcu/Scoped_guard.hpp>
+#include <xmcu/bit.hpp>
+#include <xmcu/non_constructible.hpp>
+
+// soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/base.hpp>
+#include <soc/st/arm/m0/u0/rm0503/clocks/hclk.hpp>
+#include <soc/st/arm/m0/u0/rm0503/clocks/pclk.hpp>
+#include <soc/st/arm/m0/u0/rm0503/clocks/sysclk.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/hse.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/hsi16.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/msi.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/pll.hpp>
+#include <soc/st/arm/m0/u0/rm0503/peripherals/INTERNAL_FLASH/internal_flash.hpp>
+#include <soc/st/arm/m0/u0/rm0503/peripherals/POWER/pwr.hpp>
+#include <soc/st/arm/nvic.hpp>
+
+namespace soc::st::arm::m0::u0::rm0503::clocks {
+struct frequency_scaling : private xmcu::non_constructible
+{
+    enum class Event : std::uint32_t
+    {
+        prepare, // clocks still old, ongoing transfers have to be finished and peripheral stopped
+        complete // clocks already new, dividers have to be recomputed and peripheral restarted
+    };
+
+    struct Frequencies
+    {
+        std::uint32_t sysclk_Hz = 0u;
+        std::uint32_t hclk_Hz = 0u;
+        std::uint32_t pclk_Hz = 0u;
+    };
+
+    using Handler = void (*)(Event event_a, const Frequencies& from_a, const Frequencies& to_a, void* p_context_a);
+
+    constexpr static std::uint32_t max_handlers_count = 8u;
+
+    static bool register_handler(Handler handler_a, void* p_context_a)
+    {
+        assert(nullptr != handler_a);
+
+        xmcu::Scoped_guard<nvic> guard;
+
+        for (Entry& entry : handlers)
+        {
+            if (nullptr == entry.handler)
+            {
+                entry = { .handler = handler_a, .p_context = p_context_a };
+                return true;
+            }
+        }
+
+        return false;
+    }
+    static void unregister_handler(Handler handler_a, void* p_context_a)
+    {
+        xmcu::Scoped_guard<nvic> guard;
+
+        for (Entry& entry : handlers)
+        {
+            if (handler_a == entry.handler && p_context_a == entry.p_context)
+            {
+                entry = { .handler = nullptr, .p_context = nullptr };
+            }
+        }
+    }
+
+    // source_t has to be running already
+    template<typename source_t> static void set_source()
+    {
+        static_assert(std::is_same_v<source_t, oscillators::hsi16> || std::is_same_v<source_t, oscillators::msi> ||
+                      std::is_same_v<source_t, oscillators::hse> || std::is_same_v<source_t, oscillators::pll::R>);
+
+        std::uint32_t sysclk_Hz = 0u;
+
+        if constexpr (true == std::is_same_v<source_t, oscillators::pll::R>)
+        {
+            assert(true == oscillators::pll::is_ready());
+            sysclk_Hz = oscillators::pll::r.get_frequency_Hz();
+        }
+        else
+        {
+            assert(true == source_t::is_ready());
+            sysclk_Hz = source_t::get_frequency_Hz();
+        }
+
+        scale(sysclk_Hz, []() { sysclk::set_traits<sysclk::traits::source<source_t>>(); });
+    }
+
+    // retunes MSI in place when it drives SYSCLK, otherwise only the range is changed
+    static void set_msi_frequency(oscillators::msi::Run::Frequency frequency_a)
+    {
+        if (false == sysclk::is_trait<sysclk::traits::source<oscillators::msi>>())
+        {
+            oscillators::msi::Run::set_frequency(frequency_a);
+            return;
+        }
+
+        const std::uint32_t sysclk_Hz = freq_Hz_lut[static_cast<std::uint32_t>(frequency_a) >> RCC_CR_MSIRANGE_Pos];
+        const std::uint32_t hpre_shift = details::hpre_shift_lut[xmcu::bit::flag::get(RCC->CFGR, RCC_CFGR_HPRE) >> RCC_CFGR_HPRE_Pos];
+
+        scale(sysclk_Hz, [frequency_a, sysclk_Hz, hpre_shift]() {
+            peripherals::internal_flash::set_hclk_frequency(sysclk_Hz >> hpre_shift, [frequency_a]() {
+                oscillators::msi::Run::set_frequency(frequency_a);
+                oscillators::msi::Run::set_active();
+            });
+        });
+    }
+
+    // clocks already changed by hardware (HSE CSS failover), NMI safe: only keeps the last frequencies published by
+    // the cache (the ones consumers were configured with) and drops the cache; handlers run from notify_forced_change()
+    static void set_forced_change_pending()
+    {
+        if (false == forced_change_pending)
+        {
+            const details::frequency_cache::Entry& published = details::frequency_cache::get();
+
+            forced_from = { .sysclk_Hz = published.sysclk_Hz, .hclk_Hz = published.hclk_Hz, .pclk_Hz = published.pclk_Hz };
+            forced_change_pending = true;
+        }
+
+        details::frequency_cache::invalidate();
+    }
+    // handlers get both events back to back, has to run at a priority which lets them wait for their peripherals
+    static void notify_forced_change()
+    {
+        if (false == forced_change_pending)
+        {
+            return;
+        }
+
+        forced_change_pending = false;
+
+        const Frequencies from = forced_from;
+        const Frequencies to = { .sysclk_Hz = sysclk::get_frequency_Hz(),
+                                 .hclk_Hz = hclk::get_frequency_Hz(),
+                                 .pclk_Hz = pclk::get_frequency_Hz() };
+
+        if (0u != from.sysclk_Hz)
+        {
+            notify(Event::prepare, from, to);
+            notify(Event::complete, from, to);
+        }
+    }
+
+private:
+    struct Entry
+    {
+        Handler handler;
+        void* p_context;
+    };
+
+    constexpr static std::uint32_t voltage_range_2_max_Hz = 16'000'000u;
+
+    static void notify(Event event_a, const Frequencies& from_a, const Frequencies& to_a)
+    {
+        for (const Entry& entry : handlers)
+        {
+            if (nullptr != entry.handler)
+            {
+                entry.handler(event_a, from_a, to_a, entry.p_context);
+            }
+        }
+    }
+
+    // range 1 is entered before speeding up, range 2 after slowing down (PLL needs range 1)
+    template<typename Function_t> static void scale(std::uint32_t sysclk_Hz_a, const Function_t& change_a)
+    {
+        using namespace peripherals;
+
+        const std::uint32_t cfgr = RCC->CFGR;
+        const std::uint32_t hpre_shift = details::hpre_shift_lut[xmcu::bit::flag::get(cfgr, RCC_CFGR_HPRE) >> RCC_CFGR_HPRE_Pos];
+        const std::uint32_t ppre_shift = details::ppre_shift_lut[xmcu::bit::flag::get(cfgr, RCC_CFGR_PPRE) >> RCC_CFGR_PPRE_Pos];
+
+        const Frequencies from = { .sysclk_Hz = sysclk::get_frequency_Hz(),
+                                   .hclk_Hz = hclk::get_frequency_Hz(),
+                                   .pclk_Hz = pclk::get_frequency_Hz() };
+        const Frequencies to = { .sysclk_Hz = sysclk_Hz_a,
+                                 .hclk_Hz = sysclk_Hz_a >> hpre_shift,
+                                 .pclk_Hz = (sysclk_Hz_a >> hpre_shift) >> ppre_shift };
+
+        notify(Event::prepare, from, to);
+
+        pwr::clock::enable();
+
+        {
+            xmcu::Scoped_guard<nvic> guard;
+
+            if (to.sysclk_Hz > voltage_range_2_max_Hz && pwr::Voltage_scaling::range_2 == pwr::get_voltage_scaling())
+            {
+                pwr::set_voltage_scaling(pwr::Voltage_scaling::range_1);
+            }
+
+            change_a();
+
+            if (to.sysclk_Hz <= voltage_range_2_max_Hz && false == oscillators::pll::is_enabled() &&
+                pwr::Voltage_scaling::range_1 == pwr::get_voltage_scaling())
+            {
+                const internal_flash::Latency latency = internal_flash::get_minimal_latency(to.hclk_Hz, pwr::Voltage_scaling::range_2);
+
+                if (static_cast<std::uint32_t>(latency) > static_cast<std::uint32_t>(internal_flash::get_latency()))
+                {
+                    internal_flash::set_latency(latency);
+                    internal_flash::prefetch::enable();
+                }
+
+                pwr::set_voltage_scaling(pwr::Voltage_scaling::range_2);
+            }
+        }
+
+        pwr::clock::disable();
+
+        notify(Event::complete, from, to);
+    }
+
+    inline static Entry handlers[max_handlers_count];
+    inline static Frequencies forced_from = { .sysclk_Hz = 0u, .hclk_Hz = 0u, .pclk_Hz = 0u };
+    inline static volatile bool forced_change_pending = false;
+};
+} // namespace soc::st::arm::m0::u0::rm0503::clocks
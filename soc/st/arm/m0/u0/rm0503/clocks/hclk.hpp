@@ -21,6 +21,7 @@
 // soc
 #include <soc/st/arm/m0/u0/rm0503/clocks/base.hpp>
 #include <soc/st/arm/m0/u0/rm0503/clocks/sysclk.hpp>
+#include <soc/st/arm/m0/u0/rm0503/peripherals/INTERNAL_FLASH/internal_flash.hpp>
 
 namespace soc::st::arm::m0::u0::rm0503::clocks {
 namespace ll {
@@ -52,7 +53,11 @@ struct hclk : private xmcu::non_constructible
 
     static void set_descriptor(Descriptor descriptor_a)
     {
-        xmcu::bit::flag::set(&(RCC->CFGR), RCC_CFGR_HPRE, static_cast<std::uint32_t>(descriptor_a.prescaler));
+        const std::uint32_t hpre = static_cast<std::uint32_t>(descriptor_a.prescaler);
+
+        peripherals::internal_flash::set_hclk_frequency(sysclk::get_frequency_Hz() >> details::hpre_shift_lut[hpre >> RCC_CFGR_HPRE_Pos],
+                                               [hpre]() { xmcu::bit::flag::set(&(RCC->CFGR), RCC_CFGR_HPRE, hpre); });
+        details::frequency_cache::invalidate();
     }
 
     [[nodiscard]] static Descriptor get_descriptor()
@@ -62,9 +67,12 @@ struct hclk : private xmcu::non_constructible
 
     [[nodiscard]] static std::uint32_t get_frequency_Hz()
     {
-        const std::uint32_t lut_pos = (xmcu::bit::flag::get(RCC->CFGR, RCC_CFGR_HPRE) >> RCC_CFGR_HPRE_Pos) -
-                                      (static_cast<std::uint32_t>(Descriptor::Prescaler::_1) >> RCC_CFGR_HPRE_Pos);
-        return sysclk::get_frequency_Hz() >> details::shift_lut[lut_pos];
+        if (false == details::frequency_cache::valid)
+        {
+            details::frequency_cache::update();
+        }
+
+        return details::frequency_cache::get().hclk_Hz;
     }
 };
 } // namespace soc::st::arm::m0::u0::rm0503::clocks
\ No newline at end of file
@@ -0,0 +1,226 @@
+#pragma once
+
+/*
+ *	Name: hsi16_trimming.hpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+// std
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+// CMSIS
+#include <stm32u0xx.h>
+
+// xmcu
+#include <xmcu/bit.hpp>
+#include <xmcu/non_constructible.hpp>
+
+// soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/pclk.hpp>
+#include <soc/st/arm/m0/u0/rm0503/clocks/peripheral_clock.hpp>
+#include <soc/st/arm/m0/u0/rm0503/clocks/sysclk.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/hsi16.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/lse.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/pll.hpp>
+
+namespace soc::st::arm::m0::u0::rm0503::clocks {
+// HSI16 measured against LSE: TIM16 (clocked from HSI16 through SYSCLK) captures every 8th LSE edge on TI1,
+// HSITRIM is stepped until the error stops decreasing. TIM16 is borrowed for the measurement time only.
+// Everything here busy-waits on captures (and std::chrono::steady_clock), so it has to run in thread context.
+struct hsi16_trimming : private xmcu::non_constructible
+{
+    enum class Status : std::uint32_t
+    {
+        ok,
+        lse_timeout // no LSE edge within capture_timeout
+    };
+
+    struct Descriptor
+    {
+        std::uint32_t captures = 16u; // measurement window, each capture is 8 LSE periods (~244us)
+        std::uint32_t max_iterations = 16u;
+        std::uint32_t tolerance_ppm = 0u; // 0 - closest achievable trimming
+    };
+
+    struct Result
+    {
+        Status status;
+        std::uint8_t trimming;
+        std::int32_t error_ppm;
+    };
+
+    constexpr static std::chrono::milliseconds capture_timeout = std::chrono::milliseconds(10);
+
+    // HSI16 frequency error (positive - too fast), blocks for captures_a * 8 LSE periods
+    [[nodiscard]] static std::pair<Status, std::int32_t> measure_ppm(std::uint32_t captures_a)
+    {
+        assert(captures_a > 0u);
+        assert(true == oscillators::lse::is_ready());
+        assert(true == sysclk::is_trait<sysclk::traits::source<oscillators::hsi16>>() ||
+               (true == sysclk::is_trait<sysclk::traits::source<oscillators::pll::R>>() &&
+                true == oscillators::pll::is_trait<oscillators::pll::traits::source<oscillators::hsi16>>()));
+
+        peripheral_clock::acquire<peripheral_clock::Bus::apb2, RCC_APBENR2_TIM16EN>();
+
+        TIM16->CR1 = 0x0u;
+        TIM16->PSC = 0x0u;
+        TIM16->ARR = 0xFFFFu;
+        TIM16->TISEL = TIM_TISEL_TI1SEL_1; // ti1_in2 - LSE
+        TIM16->CCMR1 = TIM_CCMR1_CC1S_0 | TIM_CCMR1_IC1PSC;
+        TIM16->CCER = TIM_CCER_CC1E;
+        TIM16->EGR = TIM_EGR_UG;
+        TIM16->SR = 0x0u;
+        TIM16->CR1 = TIM_CR1_CEN;
+
+        std::uint32_t ticks = 0u;
+        std::uint32_t count = 0u;
+        std::uint16_t previous = 0u;
+        bool captured = wait_for_capture(&previous);
+
+        while (true == captured && count < captures_a)
+        {
+            std::uint16_t current = 0u;
+
+            if (false == wait_for_capture(&current))
+            {
+                captured = false;
+                break;
+            }
+
+            // capture lost (interrupted for too long), start over
+            if (true == xmcu::bit::flag::is(TIM16->SR, TIM_SR_CC1OF))
+            {
+                xmcu::bit::flag::clear(&(TIM16->SR), TIM_SR_CC1OF);
+                ticks = 0u;
+                count = 0u;
+            }
+            else
+            {
+                ticks += static_cast<std::uint16_t>(current - previous);
+                count++;
+            }
+
+            previous = current;
+        }
+
+        TIM16->CR1 = 0x0u;
+        TIM16->CCER = 0x0u;
+
+        peripheral_clock::release<peripheral_clock::Bus::apb2, RCC_APBENR2_TIM16EN>();
+
+        if (false == captured)
+        {
+            return { Status::lse_timeout, 0 };
+        }
+
+        // timer kernel clock is doubled when APB is divided
+        const std::uint64_t timer_Hz = static_cast<std::uint64_t>(pclk::get_frequency_Hz()) *
+                                       (0x0u == xmcu::bit::flag::get(RCC->CFGR, RCC_CFGR_PPRE) ? 1u : 2u);
+        const std::int64_t expected = static_cast<std::int64_t>(timer_Hz * 8u * captures_a / oscillators::lse::get_frequency_Hz());
+
+        return { Status::ok, static_cast<std::int32_t>((static_cast<std::int64_t>(ticks) - expected) * 1'000'000 / expected) };
+    }
+
+    // closed loop, starts from the current HSITRIM; on Status::lse_timeout the best trimming found so far is kept
+    static Result trim(const Descriptor& descriptor_a)
+    {
+        constexpr std::int32_t trimming_max = RCC_ICSCR_HSITRIM_Msk >> RCC_ICSCR_HSITRIM_Pos;
+
+        const std::pair<Status, std::int32_t> initial = measure_ppm(descriptor_a.captures);
+        Result best = { .status = initial.first, .trimming = oscillators::hsi16::get_trimming(), .error_ppm = initial.second };
+
+        if (Status::ok != best.status)
+        {
+            return best;
+        }
+
+        const std::int32_t step = best.error_ppm > 0 ? -1 : 1;
+
+        for (std::uint32_t i = 0u; i < descriptor_a.max_iterations && get_abs(best.error_ppm) > descriptor_a.tolerance_ppm; i++)
+        {
+            const std::int32_t next = static_cast<std::int32_t>(best.trimming) + step;
+
+            if (next < 0 || next > trimming_max)
+            {
+                break;
+            }
+
+            oscillators::hsi16::set_trimming(static_cast<std::uint8_t>(next));
+            const auto [status, error_ppm] = measure_ppm(descriptor_a.captures);
+
+            if (Status::ok != status)
+            {
+                oscillators::hsi16::set_trimming(best.trimming);
+                best.status = status;
+                break;
+            }
+            if (get_abs(error_ppm) >= get_abs(best.error_ppm))
+            {
+                oscillators::hsi16::set_trimming(best.trimming);
+                break;
+            }
+
+            best = { .status = Status::ok, .trimming = static_cast<std::uint8_t>(next), .error_ppm = error_ppm };
+
+            // crossed the target, next step can't be better
+            if ((error_ppm > 0) == (step > 0))
+            {
+                break;
+            }
+        }
+
+        return best;
+    }
+
+    // to be polled from thread context (never from an interrupt): once period_a elapsed it re-trims, blocking for up to
+    // (max_iterations + 1) measurements (~66 ms with the defaults); returns true when trimming was run
+    static bool update(const Descriptor& descriptor_a, std::chrono::milliseconds period_a)
+    {
+        assert(period_a.count() > 0);
+
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        if (true == trimmed && now - last_time_point < period_a)
+        {
+            return false;
+        }
+
+        last = trim(descriptor_a);
+        last_time_point = now;
+        trimmed = true;
+
+        return true;
+    }
+
+    [[nodiscard]] static Result get_last_result()
+    {
+        return last;
+    }
+
+private:
+    static bool wait_for_capture(std::uint16_t* p_value_a)
+    {
+        if (false == xmcu::bit::wait_for::all_set(TIM16->SR, TIM_SR_CC1IF, capture_timeout))
+        {
+            return false;
+        }
+
+        *p_value_a = static_cast<std::uint16_t>(TIM16->CCR1); // clears CC1IF
+        return true;
+    }
+
+    constexpr static std::uint32_t get_abs(std::int32_t value_a)
+    {
+        return static_cast<std::uint32_t>(value_a < 0 ? -value_a : value_a);
+    }
+
+    inline static bool trimmed = false;
+    inline static std::chrono::steady_clock::time_point last_time_point;
+    inline static Result last = { .status = Status::ok, .trimming = 0x0u, .error_ppm = 0 };
+};
+} // namespace soc::st::arm::m0::u0::rm0503::clocks
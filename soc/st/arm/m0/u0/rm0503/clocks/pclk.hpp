@@ -35,7 +35,7 @@ struct pclk : private xmcu::non_constructible
     {
         enum class Prescaler : std::uint32_t
         {
-            _1 = RCC_CFGR_PPRE_0 | RCC_CFGR_PPRE_1 | RCC_CFGR_PPRE_2,
+            _1 = 0x0u,
             _2 = RCC_CFGR_PPRE_2,
             _4 = RCC_CFGR_PPRE_0 | RCC_CFGR_PPRE_2,
             _8 = RCC_CFGR_PPRE_1 | RCC_CFGR_PPRE_2,
@@ -48,6 +48,7 @@ struct pclk : private xmcu::non_constructible
     static void set_descriptor(Descriptor descriptor_a)
     {
         xmcu::bit::flag::set(&(RCC->CFGR), RCC_CFGR_PPRE, static_cast<std::uint32_t>(descriptor_a.prescaler));
+        details::frequency_cache::invalidate();
     }
 
     [[nodiscard]] static Descriptor get_descriptor()
@@ -57,9 +58,12 @@ struct pclk : private xmcu::non_constructible
 
     [[nodiscard]] static std::uint32_t get_frequency_Hz()
     {
-        const std::uint32_t lut_pos = (xmcu::bit::flag::get(RCC->CFGR, RCC_CFGR_PPRE) >> RCC_CFGR_PPRE_Pos) -
-                                      (static_cast<std::uint32_t>(Descriptor::Prescaler::_1) >> RCC_CFGR_PPRE_Pos);
-        return hclk::get_frequency_Hz() >> details::shift_lut[lut_pos];
+        if (false == details::frequency_cache::valid)
+        {
+            details::frequency_cache::update();
+        }
+
+        return details::frequency_cache::get().pclk_Hz;
     }
 };
 } // namespace soc::st::arm::m0::u0::rm0503::clocks
\ No newline at end of file
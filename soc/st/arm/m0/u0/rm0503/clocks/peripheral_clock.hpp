@@ -0,0 +1,135 @@
+#pragma once
+
+/*
+ *	Name: peripheral_clock.hpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+// std
+#include <cassert>
+#include <cstdint>
+
+// CMSIS
+#include <stm32u0xx.h>
+
+// xmcu
+#include <xmcu/Scoped_guard.hpp>
+#include <xmcu/bit.hpp>
+#include <xmcu/non_constructible.hpp>
+
+// soc
+#include <soc/st/arm/nvic.hpp>
+
+namespace soc::st::arm::m0::u0::rm0503::clocks {
+// reference counted RCC bus clock gates: the clock is enabled on the first acquire and gated on the last release,
+// so clocks shared by several drivers (GPIO ports, PWR) are not switched off under anybody's feet.
+// enable_t is the xxxEN bit, the matching xxxSMEN bit sits at the same position.
+struct peripheral_clock : private xmcu::non_constructible
+{
+    enum class Bus : std::uint32_t
+    {
+        iop,
+        ahb,
+        apb1,
+        apb2
+    };
+
+    enum class Stop_mode_activity : std::uint32_t
+    {
+        disable,
+        enable
+    };
+
+    template<Bus bus_t, std::uint32_t enable_t> static void acquire()
+    {
+        xmcu::Scoped_guard<nvic> guard;
+
+        if (0u == reference_count<bus_t, enable_t>++)
+        {
+            xmcu::bit::flag::set(get_enr<bus_t>(), enable_t);
+        }
+    }
+    template<Bus bus_t, std::uint32_t enable_t> static void release()
+    {
+        xmcu::Scoped_guard<nvic> guard;
+
+        assert((reference_count<bus_t, enable_t> > 0u));
+
+        if (0u == --reference_count<bus_t, enable_t>)
+        {
+            xmcu::bit::flag::clear(get_enr<bus_t>(), enable_t);
+        }
+    }
+
+    // SMEN, set after reset: clock keeps running in Sleep and Stop mode
+    template<Bus bus_t, std::uint32_t enable_t> static void set_stop_mode_activity(Stop_mode_activity activity_a)
+    {
+        switch (activity_a)
+        {
+            case Stop_mode_activity::disable:
+                xmcu::bit::flag::clear(get_smenr<bus_t>(), enable_t);
+                break;
+            case Stop_mode_activity::enable:
+                xmcu::bit::flag::set(get_smenr<bus_t>(), enable_t);
+                break;
+        }
+    }
+    template<Bus bus_t, std::uint32_t enable_t> [[nodiscard]] static Stop_mode_activity get_stop_mode_activity()
+    {
+        return true == xmcu::bit::flag::is(*get_smenr<bus_t>(), enable_t) ? Stop_mode_activity::enable : Stop_mode_activity::disable;
+    }
+
+    template<Bus bus_t, std::uint32_t enable_t> [[nodiscard]] static bool is_enabled()
+    {
+        return xmcu::bit::flag::is(*get_enr<bus_t>(), enable_t);
+    }
+    template<Bus bus_t, std::uint32_t enable_t> [[nodiscard]] static std::uint32_t get_reference_count()
+    {
+        return reference_count<bus_t, enable_t>;
+    }
+
+private:
+    template<Bus bus_t> static volatile std::uint32_t* get_enr()
+    {
+        if constexpr (Bus::iop == bus_t)
+        {
+            return &(RCC->IOPENR);
+        }
+        else if constexpr (Bus::ahb == bus_t)
+        {
+            return &(RCC->AHBENR);
+        }
+        else if constexpr (Bus::apb1 == bus_t)
+        {
+            return &(RCC->APBENR1);
+        }
+        else
+        {
+            return &(RCC->APBENR2);
+        }
+    }
+    template<Bus bus_t> static volatile std::uint32_t* get_smenr()
+    {
+        if constexpr (Bus::iop == bus_t)
+        {
+            return &(RCC->IOPSMENR);
+        }
+        else if constexpr (Bus::ahb == bus_t)
+        {
+            return &(RCC->AHBSMENR);
+        }
+        else if constexpr (Bus::apb1 == bus_t)
+        {
+            return &(RCC->APBSMENR1);
+        }
+        else
+        {
+            return &(RCC->APBSMENR2);
+        }
+    }
+
+    template<Bus bus_t, std::uint32_t enable_t> inline static std::uint32_t reference_count = 0u;
+};
+} // namespace soc::st::arm::m0::u0::rm0503::clocks
@@ -0,0 +1,230 @@
+#pragma once
+
+/*
+ *	Name: startup.hpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+// std
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+// xmcu
+#include <xmcu/non_constructible.hpp>
+
+// soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/clock_tree.hpp>
+#include <soc/st/arm/m0/u0/rm0503/clocks/sysclk.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/lse.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/msi.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/pll.hpp>
+#include <soc/st/arm/m0/u0/rm0503/peripherals/POWER/pwr.hpp>
+
+namespace soc::st::arm::m0::u0::rm0503::clocks {
+// non blocking clock_tree::Plan<>::apply(): oscillators start together and the core keeps running from the current
+// SYSCLK (MSI after reset) until the target is ready; update() is expected to be called periodically (e.g. from the main loop),
+// timeouts are measured with std::chrono::steady_clock
+template<typename plan_t> struct startup : private xmcu::non_constructible
+{
+    enum class Status : std::uint32_t
+    {
+        idle,
+        running,
+        done,
+        timeout
+    };
+
+    struct Descriptor
+    {
+        bool lse = false;
+        bool msi_pll_mode = false; // MSI locked to LSE once it's ready, requires lse
+
+        // 0 - no timeout; source and lse from start(), pll from the moment it's started
+        std::chrono::milliseconds source_timeout = std::chrono::milliseconds::zero();
+        std::chrono::milliseconds pll_timeout = std::chrono::milliseconds::zero();
+        std::chrono::milliseconds lse_timeout = std::chrono::milliseconds::zero();
+    };
+
+    struct Timeouts
+    {
+        bool source = false;
+        bool pll = false;
+        bool lse = false;
+    };
+
+    static void start(const Descriptor& descriptor_a)
+    {
+        assert(false == descriptor_a.msi_pll_mode || true == descriptor_a.lse);
+
+        descriptor = descriptor_a;
+        timeouts = {};
+        start_time_point = std::chrono::steady_clock::now();
+        pll_start_time_point = start_time_point;
+        lse_pending = descriptor_a.lse;
+
+        // PWR clock is held for the backup domain access until LSE is up (or timed out)
+        if (true == lse_pending && false == oscillators::lse::is_ready())
+        {
+            if (false == pwr_clock_held)
+            {
+                peripherals::pwr::clock::enable();
+                pwr_clock_held = true;
+            }
+            peripherals::pwr::backup_domain::enable_write_access();
+            oscillators::lse::enable();
+        }
+
+        plan_t::start_source();
+        state = State::source;
+    }
+
+    static Status update()
+    {
+        if (true == lse_pending)
+        {
+            if (true == oscillators::lse::is_ready())
+            {
+                lse_pending = false;
+
+                if (true == descriptor.msi_pll_mode)
+                {
+                    oscillators::msi::pll_mode::enable();
+                }
+            }
+            else if (true == is_expired(start_time_point, descriptor.lse_timeout))
+            {
+                timeouts.lse = true;
+                lse_pending = false;
+            }
+
+            if (false == lse_pending && true == pwr_clock_held)
+            {
+                peripherals::pwr::clock::disable();
+                pwr_clock_held = false;
+            }
+        }
+
+        switch (state)
+        {
+            case State::idle:
+            case State::done:
+            case State::failed:
+                break;
+
+            case State::source: {
+                if (true == Source::is_ready())
+                {
+
+                    if constexpr (true == plan_t::uses_pll)
+                    {
+                        // faster than MSI in the meantime
+                        if constexpr (false == std::is_same_v<Source, oscillators::msi>)
+                        {
+                            if (Source::get_frequency_Hz() > sysclk::get_frequency_Hz() &&
+                                false == sysclk::is_trait<sysclk::traits::source<oscillators::pll::R>>())
+                            {
+                                sysclk::set_traits<sysclk::traits::source<Source>>();
+                            }
+                        }
+
+                        plan_t::start_pll();
+                        pll_start_time_point = std::chrono::steady_clock::now();
+                        state = State::pll;
+                    }
+                    else
+                    {
+                        plan_t::switch_sysclk();
+                        state = State::done;
+                    }
+                }
+                else if (true == is_expired(start_time_point, descriptor.source_timeout))
+                {
+                    if constexpr (true == std::is_same_v<Source, oscillators::hse>)
+                    {
+                        oscillators::hse::disable();
+                    }
+
+                    timeouts.source = true;
+                    state = State::failed;
+                }
+            }
+            break;
+
+            case State::pll: {
+                if constexpr (true == plan_t::uses_pll)
+                {
+                    if (true == oscillators::pll::is_ready())
+                    {
+                        plan_t::switch_sysclk();
+                        state = State::done;
+                    }
+                    else if (true == is_expired(pll_start_time_point, descriptor.pll_timeout))
+                    {
+                        oscillators::pll::disable();
+                        timeouts.pll = true;
+                        state = State::failed;
+                    }
+                }
+            }
+            break;
+        }
+
+        return get_status();
+    }
+
+    [[nodiscard]] static Status get_status()
+    {
+        switch (state)
+        {
+            case State::idle:
+                return Status::idle;
+            case State::source:
+            case State::pll:
+                return Status::running;
+            case State::done:
+            case State::failed:
+                break;
+        }
+
+        if (true == lse_pending)
+        {
+            return Status::running;
+        }
+
+        return (true == timeouts.source || true == timeouts.pll || true == timeouts.lse) ? Status::timeout : Status::done;
+    }
+    [[nodiscard]] static Timeouts get_timeouts()
+    {
+        return timeouts;
+    }
+
+private:
+    using Source = typename plan_t::Source;
+
+    enum class State : std::uint32_t
+    {
+        idle,
+        source,
+        pll,
+        done,
+        failed
+    };
+
+    static bool is_expired(std::chrono::steady_clock::time_point start_a, std::chrono::milliseconds timeout_a)
+    {
+        return std::chrono::milliseconds::zero() != timeout_a && std::chrono::steady_clock::now() - start_a >= timeout_a;
+    }
+
+    inline static Descriptor descriptor;
+    inline static Timeouts timeouts;
+    inline static volatile State state = State::idle;
+    inline static std::chrono::steady_clock::time_point start_time_point;
+    inline static std::chrono::steady_clock::time_point pll_start_time_point;
+    inline static volatile bool lse_pending = false;
+    inline static bool pwr_clock_held = false;
+};
+} // namespace soc::st::arm::m0::u0::rm0503::clocks
@@ -0,0 +1,156 @@
+#pragma once
+
+/*
+ *	Name: stop_mode.hpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+// std
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+
+// CMSIS
+#include <stm32u0xx.h>
+
+// xmcu
+#include <xmcu/Scoped_guard.hpp>
+#include <xmcu/bit.hpp>
+#include <xmcu/non_constructible.hpp>
+
+// soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/frequency_scaling.hpp>
+#include <soc/st/arm/m0/u0/rm0503/peripherals/POWER/pwr.hpp>
+#include <soc/st/arm/nvic.hpp>
+
+namespace soc::st::arm::m0::u0::rm0503::clocks {
+// Stop turns HSE, PLL and HSI48 off and wakes up on MSI or HSI16 (STOPWUCK). Prescalers, PLL configuration, flash latency
+// and voltage range are retained, so only oscillators and the SYSCLK switch have to be restored; frequencies end up
+// the same as before entering (unless restore() times out). Until then the core runs on the wake-up clock and the frequency
+// cache is wrong.
+struct stop_mode : private xmcu::non_constructible
+{
+    struct Snapshot
+    {
+        std::uint32_t oscillators; // RCC->CR ON bits
+        std::uint32_t hsi48;       // RCC->CRRCR HSI48ON
+        std::uint32_t source;      // RCC->CFGR SW
+    };
+
+    [[nodiscard]] static Snapshot save()
+    {
+        return { .oscillators = RCC->CR & (RCC_CR_MSION | RCC_CR_HSION | RCC_CR_HSEON | RCC_CR_PLLON),
+                 .hsi48 = RCC->CRRCR & RCC_CRRCR_HSI48ON,
+                 .source = xmcu::bit::flag::get(RCC->CFGR, RCC_CFGR_SW) };
+    }
+
+    // all oscillators are started at once, PLL as soon as they are ready, SYSCLK is switched once at the end; every wait is
+    // bounded by timeout_a (std::chrono::steady_clock). false - an oscillator or the switch didn't make it in time: the core
+    // stays on the wake-up clock with HSE and PLL off and the change is reported to clocks::frequency_scaling as forced
+    // (handlers run from frequency_scaling::notify_forced_change()); HSI48 failing alone leaves SYSCLK as it was restored
+    [[nodiscard]] static bool restore(const Snapshot& snapshot_a, std::chrono::milliseconds timeout_a)
+    {
+        assert(timeout_a > std::chrono::milliseconds::zero());
+
+        const std::uint32_t wakeup_source = xmcu::bit::flag::get(RCC->CFGR, RCC_CFGR_SWS) >> RCC_CFGR_SWS_Pos;
+
+        xmcu::bit::flag::set(&(RCC->CR), snapshot_a.oscillators & ~RCC_CR_PLLON);
+        xmcu::bit::flag::set(&(RCC->CRRCR), snapshot_a.hsi48);
+
+        const std::uint32_t ready = (true == xmcu::bit::flag::is(snapshot_a.oscillators, RCC_CR_MSION) ? RCC_CR_MSIRDY : 0x0u) |
+                                    (true == xmcu::bit::flag::is(snapshot_a.oscillators, RCC_CR_HSION) ? RCC_CR_HSIRDY : 0x0u) |
+                                    (true == xmcu::bit::flag::is(snapshot_a.oscillators, RCC_CR_HSEON) ? RCC_CR_HSERDY : 0x0u);
+
+        bool ret = xmcu::bit::wait_for::all_set(RCC->CR, ready, timeout_a);
+
+        if (true == ret && true == xmcu::bit::flag::is(snapshot_a.oscillators, RCC_CR_PLLON))
+        {
+            xmcu::bit::flag::set(&(RCC->CR), RCC_CR_PLLON);
+            ret = xmcu::bit::wait_for::all_set(RCC->CR, RCC_CR_PLLRDY, timeout_a);
+        }
+        if (true == ret)
+        {
+            ret = set_source(snapshot_a.source, timeout_a);
+        }
+
+        if (false == ret)
+        {
+            // wake-up clock is running, switching back to it can't fail
+            set_source(wakeup_source, timeout_a);
+            xmcu::bit::flag::clear(&(RCC->CR), RCC_CR_HSEON | RCC_CR_PLLON);
+
+            frequency_scaling::set_forced_change_pending();
+
+            return false;
+        }
+
+        // wake-up clock which wasn't running before
+        xmcu::bit::flag::clear(&(RCC->CR), (RCC_CR_MSION | RCC_CR_HSION) & ~snapshot_a.oscillators);
+
+        if (0x0u != snapshot_a.hsi48 && false == xmcu::bit::wait_for::all_set(RCC->CRRCR, RCC_CRRCR_HSI48RDY, timeout_a))
+        {
+            xmcu::bit::flag::clear(&(RCC->CRRCR), RCC_CRRCR_HSI48ON);
+            return false;
+        }
+
+        return true;
+    }
+
+    // wakes up on HSI16 when the tree runs on it (directly or through PLL), so there is nothing to wait for before PLL;
+    // interrupts stay held off until restore() is done (PRIMASK still lets WFI wake up), the one which woke the core runs
+    // after it. steady_clock needs SysTick for restore() timeouts, so meanwhile NVIC lines are disabled instead of PRIMASK:
+    // SysTick (and PendSV) may run on the wake-up clock
+    [[nodiscard]] static bool enter(peripherals::pwr::Stop_mode mode_a, std::chrono::milliseconds timeout_a)
+    {
+        xmcu::Scoped_guard<nvic> guard;
+
+        const Snapshot snapshot = save();
+
+        if (true == uses_hsi16(snapshot))
+        {
+            xmcu::bit::flag::set(&(RCC->CFGR), RCC_CFGR_STOPWUCK);
+        }
+
+        peripherals::pwr::clock::enable();
+
+        peripherals::pwr::stop(mode_a);
+
+        peripherals::pwr::clock::disable();
+
+        // disabled lines keep their pending state
+        const std::uint32_t iser = NVIC->ISER[0];
+        NVIC->ICER[0] = iser;
+        nvic::enable();
+
+        const bool ret = restore(snapshot, timeout_a);
+
+        nvic::disable();
+        NVIC->ISER[0] = iser;
+
+        return ret;
+    }
+
+private:
+    static bool uses_hsi16(const Snapshot& snapshot_a)
+    {
+        return RCC_CFGR_SW_0 == snapshot_a.source ||
+               ((RCC_CFGR_SW_0 | RCC_CFGR_SW_1) == snapshot_a.source &&
+                RCC_PLLCFGR_PLLSRC_1 == xmcu::bit::flag::get(RCC->PLLCFGR, RCC_PLLCFGR_PLLSRC));
+    }
+
+    static bool set_source(std::uint32_t source_a, std::chrono::milliseconds timeout_a)
+    {
+        const std::chrono::steady_clock::time_point end_time_point = std::chrono::steady_clock::now() + timeout_a;
+
+        xmcu::bit::flag::set(&(RCC->CFGR), RCC_CFGR_SW, source_a);
+
+        while (source_a != xmcu::bit::flag::get(RCC->CFGR, RCC_CFGR_SWS) >> RCC_CFGR_SWS_Pos &&
+               std::chrono::steady_clock::now() < end_time_point)
+            continue;
+
+        return source_a == xmcu::bit::flag::get(RCC->CFGR, RCC_CFGR_SWS) >> RCC_CFGR_SWS_Pos;
+    }
+};
+} // namespace soc::st::arm::m0::u0::rm0503::clocks
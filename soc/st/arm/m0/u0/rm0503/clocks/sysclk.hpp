@@ -11,13 +11,17 @@
 #include <cassert>
 
 // xmcu
+#include <xmcu/Scoped_guard.hpp>
 #include <xmcu/bit.hpp>
 #include <xmcu/non_constructible.hpp>
 
 // soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/base.hpp>
 #include <soc/st/arm/m0/u0/rm0503/oscillators/hsi16.hpp>
 #include <soc/st/arm/m0/u0/rm0503/oscillators/msi.hpp>
 #include <soc/st/arm/m0/u0/rm0503/oscillators/pll.hpp>
+#include <soc/st/arm/m0/u0/rm0503/peripherals/INTERNAL_FLASH/internal_flash.hpp>
+#include <soc/st/arm/nvic.hpp>
 
 namespace soc::st::arm::m0::u0::rm0503::clocks {
 namespace ll {
@@ -39,11 +43,28 @@ struct sysclk : private xmcu::non_constructible
     template<typename triat> static bool is_trait() = delete;
 
     static std::uint32_t get_frequency_Hz();
+
+private:
+    static std::uint32_t read_frequency_Hz();
+
+    friend details::frequency_cache;
+
+    // flash latency follows the new HCLK, SWS is awaited so it's safe to lower it afterwards
+    static void set_source(std::uint32_t sw_a, std::uint32_t frequency_Hz_a)
+    {
+        const std::uint32_t hpre_shift = details::hpre_shift_lut[xmcu::bit::flag::get(RCC->CFGR, RCC_CFGR_HPRE) >> RCC_CFGR_HPRE_Pos];
+
+        peripherals::internal_flash::set_hclk_frequency(frequency_Hz_a >> hpre_shift, [sw_a]() {
+            xmcu::bit::flag::set(&(RCC->CFGR), RCC_CFGR_SW, sw_a);
+            while ((sw_a << RCC_CFGR_SWS_Pos) != xmcu::bit::flag::get(RCC->CFGR, RCC_CFGR_SWS)) continue;
+        });
+        details::frequency_cache::invalidate();
+    }
 };
 
 template<> inline void sysclk::set_traits<sysclk::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::hsi16>>()
 {
-    xmcu::bit::flag::set(&(RCC->CFGR), RCC_CFGR_SW, RCC_CFGR_SW_0);
+    sysclk::set_source(RCC_CFGR_SW_0, soc::st::arm::m0::u0::rm0503::oscillators::hsi16::get_frequency_Hz());
 }
 template<> inline bool sysclk::is_trait<sysclk::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::hsi16>>()
 {
@@ -53,16 +74,26 @@ template<> inline bool sysclk::is_trait<sysclk::traits::source<soc::st::arm::m0:
 
 template<> inline void sysclk::set_traits<sysclk::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::msi>>()
 {
-    xmcu::bit::flag::clear(&(RCC->CFGR), RCC_CFGR_SW);
+    sysclk::set_source(0x0u, soc::st::arm::m0::u0::rm0503::oscillators::msi::get_frequency_Hz());
 }
 template<> inline bool sysclk::is_trait<sysclk::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::msi>>()
 {
     return 0x0u == xmcu::bit::flag::get(RCC->CFGR, RCC_CFGR_SWS);
 }
 
+template<> inline void sysclk::set_traits<sysclk::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::hse>>()
+{
+    sysclk::set_source(RCC_CFGR_SW_1, soc::st::arm::m0::u0::rm0503::oscillators::hse::get_frequency_Hz());
+}
+template<> inline bool sysclk::is_trait<sysclk::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::hse>>()
+{
+    return false == xmcu::bit::flag::is(RCC->CFGR, RCC_CFGR_SWS_0) && true == xmcu::bit::flag::is(RCC->CFGR, RCC_CFGR_SWS_1) &&
+           false == xmcu::bit::flag::is(RCC->CFGR, RCC_CFGR_SWS_2);
+}
+
 template<> inline void sysclk::set_traits<sysclk::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::pll::R>>()
 {
-    xmcu::bit::flag::set(&(RCC->CFGR), RCC_CFGR_SW, RCC_CFGR_SW_0 | RCC_CFGR_SW_1);
+    sysclk::set_source(RCC_CFGR_SW_0 | RCC_CFGR_SW_1, soc::st::arm::m0::u0::rm0503::oscillators::pll::r.get_frequency_Hz());
 }
 template<> inline bool sysclk::is_trait<sysclk::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::pll::R>>()
 {
@@ -71,6 +102,16 @@ template<> inline bool sysclk::is_trait<sysclk::traits::source<soc::st::arm::m0:
 }
 
 inline std::uint32_t sysclk::get_frequency_Hz()
+{
+    if (false == details::frequency_cache::valid)
+    {
+        details::frequency_cache::update();
+    }
+
+    return details::frequency_cache::get().sysclk_Hz;
+}
+
+inline std::uint32_t sysclk::read_frequency_Hz()
 {
     if (true == sysclk::is_trait<sysclk::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::hsi16>>())
     {
@@ -80,6 +121,10 @@ inline std::uint32_t sysclk::get_frequency_Hz()
     {
         return soc::st::arm::m0::u0::rm0503::oscillators::msi::get_frequency_Hz();
     }
+    if (true == sysclk::is_trait<sysclk::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::hse>>())
+    {
+        return soc::st::arm::m0::u0::rm0503::oscillators::hse::get_frequency_Hz();
+    }
     if (true == sysclk::is_trait<sysclk::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::pll::R>>())
     {
         return soc::st::arm::m0::u0::rm0503::oscillators::pll::r.get_frequency_Hz();
@@ -90,4 +135,36 @@ inline std::uint32_t sysclk::get_frequency_Hz()
     return 0;
 }
 
+// registers are read and the entry published with interrupts masked: an invalidate() from an interrupt can't be overwritten
+// by a stale valid flag. NMI isn't masked, when it invalidated the cache meanwhile RCC is walked again
+inline void details::frequency_cache::update()
+{
+    xmcu::Scoped_guard<nvic> guard;
+
+    while (true)
+    {
+        const std::uint32_t start_generation = frequency_cache::generation;
+
+        const std::uint32_t cfgr = RCC->CFGR;
+        const std::uint32_t sysclk_frequency_Hz = sysclk::read_frequency_Hz();
+        const std::uint32_t hclk_frequency_Hz =
+            sysclk_frequency_Hz >> hpre_shift_lut[xmcu::bit::flag::get(cfgr, RCC_CFGR_HPRE) >> RCC_CFGR_HPRE_Pos];
+        const std::uint32_t pclk_frequency_Hz =
+            hclk_frequency_Hz >> ppre_shift_lut[xmcu::bit::flag::get(cfgr, RCC_CFGR_PPRE) >> RCC_CFGR_PPRE_Pos];
+
+        const std::uint32_t next = frequency_cache::published ^ 0x1u;
+
+        frequency_cache::entries[next] = { .sysclk_Hz = sysclk_frequency_Hz, .hclk_Hz = hclk_frequency_Hz, .pclk_Hz = pclk_frequency_Hz };
+        frequency_cache::published = next;
+        frequency_cache::valid = true;
+
+        if (start_generation == frequency_cache::generation)
+        {
+            return;
+        }
+
+        frequency_cache::valid = false;
+    }
+}
+
 } // namespace soc::st::arm::m0::u0::rm0503::clocks
\ No newline at end of file
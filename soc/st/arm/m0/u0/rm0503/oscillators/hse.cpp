@@ -0,0 +1,34 @@
+/*
+ *	Name: hse.cpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+#if XMCU_SOC_ARCH_CORE_FAMILY == m0 && XMCU_SOC_VENDOR_FAMILY == stm32u0 && XMCU_SOC_VENDOR_FAMILY_RM == rm0503
+
+// soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/frequency_scaling.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/hse.hpp>
+
+namespace soc::st::arm::m0::u0::rm0503::oscillators {
+using namespace xmcu;
+
+bool hse_css_isr_handler()
+{
+    if (false == bit::flag::is(RCC->CIFR, RCC_CIFR_CSSF))
+    {
+        return false;
+    }
+
+    // NMI keeps firing until CSSF is cleared
+    bit::flag::set(&(RCC->CICR), RCC_CICR_CSSC);
+
+    hse::css::fault_count = hse::css::fault_count + 1u;
+    clocks::frequency_scaling::set_forced_change_pending();
+
+    return true;
+}
+} // namespace soc::st::arm::m0::u0::rm0503::oscillators
+
+#endif
@@ -18,6 +18,7 @@
 #include <xmcu/non_constructible.hpp>
 
 // soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/base.hpp>
 #include <soc/st/arm/m0/u0/rm0503/peripherals/GPIO/gpio.hpp>
 
 namespace soc::st::arm::m0::u0::rm0503::oscillators {
@@ -41,8 +42,39 @@ struct hse : private xmcu::non_constructible
 };
 } // namespace ll
 
+// to be called from the application NMI_Handler, false - NMI not raised by CSS
+bool hse_css_isr_handler();
+
 struct hse : private xmcu::non_constructible
 {
+    // on HSE failure hardware stops HSE (and HSE-fed PLL) and moves SYSCLK to HSI16 raising NMI, hse_css_isr_handler()
+    // clears the flag and marks the change; clocks::frequency_scaling::notify_forced_change() has to be called afterwards
+    // outside of the NMI (PendSV, thread) to let the handlers re-time; CSS can be turned off only by reset
+    struct css : private xmcu::non_constructible
+    {
+        static void enable()
+        {
+            assert(true == hse::is_ready());
+
+            xmcu::bit::flag::set(&(RCC->CR), RCC_CR_CSSON);
+        }
+
+        [[nodiscard]] static bool is_enabled()
+        {
+            return xmcu::bit::flag::is(RCC->CR, RCC_CR_CSSON);
+        }
+
+        [[nodiscard]] static std::uint32_t get_fault_count()
+        {
+            return fault_count;
+        }
+
+    private:
+        inline static volatile std::uint32_t fault_count = 0u;
+
+        friend bool hse_css_isr_handler();
+    };
+
     struct traits : private xmcu::non_constructible
     {
     private:
@@ -92,6 +124,7 @@ struct hse : private xmcu::non_constructible
 
         xmcu::bit::flag::set(&(RCC->CR), RCC_CR_HSEON);
         frequency_Hz = frequency_Hz_a;
+        clocks::details::frequency_cache::invalidate();
     }
     static void disable()
     {
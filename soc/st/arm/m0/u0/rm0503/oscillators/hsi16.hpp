@@ -70,6 +70,18 @@ struct hsi16 : private xmcu::non_constructible
         xmcu::bit::flag::clear(&(RCC->CR), RCC_CR_HSION);
     }
 
+    // HSITRIM, 64 after reset
+    static void set_trimming(std::uint8_t value_a)
+    {
+        assert(value_a <= (RCC_ICSCR_HSITRIM_Msk >> RCC_ICSCR_HSITRIM_Pos));
+
+        xmcu::bit::flag::set(&(RCC->ICSCR), RCC_ICSCR_HSITRIM, static_cast<std::uint32_t>(value_a) << RCC_ICSCR_HSITRIM_Pos);
+    }
+    [[nodiscard]] static std::uint8_t get_trimming()
+    {
+        return static_cast<std::uint8_t>(xmcu::bit::flag::get(RCC->ICSCR, RCC_ICSCR_HSITRIM) >> RCC_ICSCR_HSITRIM_Pos);
+    }
+
     [[nodiscard]] static bool is_ready()
     {
         return xmcu::bit::flag::is(RCC->CR, RCC_CR_HSIRDY);
@@ -18,7 +18,7 @@
 #include <soc/st/arm/m0/u0/rm0503/peripherals/GPIO/gpio.hpp>
 
 namespace soc::st::arm::m0::u0::rm0503::oscillators {
-namespace deatils {
+namespace details {
 template<auto... pins_t> struct LSE_pins
 {
     static constexpr bool is(auto value_a)
@@ -28,10 +28,10 @@ template<auto... pins_t> struct LSE_pins
 };
 
 #if XMCU_SOC_STM32_MODEL == stm32l0u083rct6u
-constexpr LSE_pins<peripherals::gpio::C::_14> osc_in;
-constexpr LSE_pins<peripherals::gpio::C::_15> osc_out;
+constexpr LSE_pins<peripherals::gpio::C::_14> lse_osc_in;
+constexpr LSE_pins<peripherals::gpio::C::_15> lse_osc_out;
 #endif
-} // namespace deatils
+} // namespace details
 } // namespace soc::st::arm::m0::u0::rm0503::oscillators
 
 namespace soc::st::arm::m0::u0::rm0503::oscillators {
@@ -76,15 +76,15 @@ struct lse : private xmcu::non_constructible
         };
     };
 
-    template<typename trait_t> void set_traits()
+    template<typename trait_t> static void set_traits()
     {
         if constexpr (traits::Source::xtal == trait_t::type)
         {
-            static_assert(true == details::osc_in.is(trait_t::osc_in_pin));
-            static_assert(true == details::osc_out.is(trait_t::osc_out_pin));
+            static_assert(true == details::lse_osc_in.is(trait_t::osc_in_pin));
+            static_assert(true == details::lse_osc_out.is(trait_t::osc_out_pin));
 
             assert(false == lse::is_enabled());
-            xmcu::bit::flag::clear(&(RCC->BDCR), RCC_BDCR_LSEBYP | trait_t::drive);
+            xmcu::bit::flag::clear(&(RCC->BDCR), RCC_BDCR_LSEBYP | RCC_BDCR_LSEDRV);
             xmcu::bit::flag::set(&(RCC->BDCR), static_cast<std::uint32_t>(trait_t::drive));
         }
         else
@@ -98,8 +98,10 @@ struct lse : private xmcu::non_constructible
     {
         xmcu::bit::flag::set(&(RCC->BDCR), RCC_BDCR_LSEON | RCC_BDCR_LSESYSEN);
     }
+    // MSI PLL mode has to be left before LSE goes away
     static void disable()
     {
+        xmcu::bit::flag::clear(&(RCC->CR), RCC_CR_MSIPLLEN);
         xmcu::bit::flag::clear(&(RCC->BDCR), RCC_BDCR_LSEON | RCC_BDCR_LSESYSEN);
     }
 
@@ -20,8 +20,12 @@
 #include <xmcu/non_constructible.hpp>
 #include <xmcu/various.hpp>
 
+// soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/base.hpp>
+#include <soc/st/arm/m0/u0/rm0503/oscillators/lse.hpp>
+
 namespace {
-constexpr std::uint32_t freq_Hz_lut[] = { 100u,       200u,       400u,        800u,        1'000'000u,  2'000'000u,
+constexpr std::uint32_t freq_Hz_lut[] = { 100'000u,   200'000u,   400'000u,    800'000u,    1'000'000u,  2'000'000u,
                                           4'000'000u, 8'000'000u, 16'000'000u, 24'000'000u, 32'000'000u, 48'000'000u };
 }
 
@@ -64,11 +68,13 @@ struct msi : private xmcu::non_constructible
             assert(false == xmcu::bit::flag::is(RCC->CR, RCC_CR_MSION) || true == xmcu::bit::flag::is(RCC->CR, RCC_CR_MSIRDY));
 
             xmcu::bit::flag::set(&(RCC->CR), RCC_CR_MSIRANGE, static_cast<std::uint32_t>(frequency_a));
+            clocks::details::frequency_cache::invalidate();
         }
 
         static void set_active()
         {
             xmcu::bit::flag::set(&(RCC->CR), RCC_CR_MSIRGSEL);
+            clocks::details::frequency_cache::invalidate();
         }
 
         static bool is_active()
@@ -97,6 +103,7 @@ struct msi : private xmcu::non_constructible
             assert(true == xmcu::bit::flag::is(RCC->CR, RCC_CR_MSIRGSEL));
 
             xmcu::bit::flag::set(&(RCC->CSR), RCC_CSR_MSISTBYRG, static_cast<std::uint32_t>(frequency_a));
+            clocks::details::frequency_cache::invalidate();
         }
 
         static bool is_active()
@@ -110,6 +117,44 @@ struct msi : private xmcu::non_constructible
         }
     };
 
+    // MSI locked to LSE, hardware drops it (and LSECSSD is set) when LSE fails
+    struct pll_mode : private xmcu::non_constructible
+    {
+        enum class Status : std::uint32_t
+        {
+            disabled,
+            enabled,
+            lse_failure
+        };
+
+        static void enable()
+        {
+            assert(true == lse::is_ready());
+            assert(false == xmcu::bit::flag::is(RCC->BDCR, RCC_BDCR_LSECSSD));
+
+            xmcu::bit::flag::set(&(RCC->CR), RCC_CR_MSIPLLEN);
+        }
+        static void disable()
+        {
+            xmcu::bit::flag::clear(&(RCC->CR), RCC_CR_MSIPLLEN);
+        }
+
+        [[nodiscard]] static bool is_enabled()
+        {
+            return xmcu::bit::flag::is(RCC->CR, RCC_CR_MSIPLLEN);
+        }
+
+        [[nodiscard]] static Status get_status()
+        {
+            if (true == xmcu::bit::flag::is(RCC->BDCR, RCC_BDCR_LSECSSD))
+            {
+                return Status::lse_failure;
+            }
+
+            return true == is_enabled() && true == lse::is_ready() ? Status::enabled : Status::disabled;
+        }
+    };
+
     static void set_descriptor(const Descriptor& descriptor_a)
     {
         xmcu::bit::flag::set(&(RCC->ICSCR), 0xFFu, static_cast<std::uint32_t>(descriptor_a.calibration) & 0xFFu);
@@ -155,7 +200,7 @@ struct msi : private xmcu::non_constructible
         }
     }
 
-    static Run run;
-    static Standby standby;
+    inline static Run run;
+    inline static Standby standby;
 };
 } // namespace soc::st::arm::m0::u0::rm0503::oscillators
\ No newline at end of file
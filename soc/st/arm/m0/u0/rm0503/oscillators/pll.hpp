@@ -19,6 +19,7 @@
 #include <xmcu/non_constructible.hpp>
 
 // soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/base.hpp>
 #include <soc/st/arm/m0/u0/rm0503/oscillators/hse.hpp>
 #include <soc/st/arm/m0/u0/rm0503/oscillators/hsi16.hpp>
 #include <soc/st/arm/m0/u0/rm0503/oscillators/msi.hpp>
@@ -73,12 +74,12 @@ struct pll : private xmcu::non_constructible
 
         [[nodiscard]] bool is_enabled() const
         {
-            return xmcu::bit::flag::is(RCC->PLLCFGR, RCC_PLLCFGR_PLLREN);
+            return xmcu::bit::flag::is(RCC->PLLCFGR, RCC_PLLCFGR_PLLPEN);
         }
 
         [[nodiscard]] std::uint32_t get_frequency_Hz() const
         {
-            return 0u;
+            return pll::get_vco_frequency_Hz() / ((xmcu::bit::flag::get(RCC->PLLCFGR, RCC_PLLCFGR_PLLP) >> RCC_PLLCFGR_PLLP_Pos) + 1u);
         }
     };
     struct R : private xmcu::non_copyable
@@ -91,6 +92,7 @@ struct pll : private xmcu::non_constructible
         void set_descriptor(Descriptor descriptor_a)
         {
             xmcu::bit::flag::set(&(RCC->PLLCFGR), RCC_PLLCFGR_PLLR, (descriptor_a.divider - 1u) << RCC_PLLCFGR_PLLR_Pos);
+            clocks::details::frequency_cache::invalidate();
         }
         [[nodiscard]] Descriptor get_descriptor() const
         {
@@ -113,7 +115,7 @@ struct pll : private xmcu::non_constructible
 
         [[nodiscard]] std::uint32_t get_frequency_Hz() const
         {
-            return 0u;
+            return pll::get_vco_frequency_Hz() / ((xmcu::bit::flag::get(RCC->PLLCFGR, RCC_PLLCFGR_PLLR) >> RCC_PLLCFGR_PLLR_Pos) + 1u);
         }
     };
     struct Q : private xmcu::non_copyable
@@ -148,45 +150,71 @@ struct pll : private xmcu::non_constructible
 
         [[nodiscard]] std::uint32_t get_frequency_Hz() const
         {
-            return 0u;
+            return pll::get_vco_frequency_Hz() / ((xmcu::bit::flag::get(RCC->PLLCFGR, RCC_PLLCFGR_PLLQ) >> RCC_PLLCFGR_PLLQ_Pos) + 1u);
         }
     };
 
-    static P p;
-    static Q q;
-    static R r;
+    inline static P p;
+    inline static Q q;
+    inline static R r;
 
-    template<typename trait> void set_traits() = delete;
-    template<typename trait> [[nodiscard]] bool is_trait() = delete;
+    template<typename trait> static void set_traits() = delete;
+    template<typename trait> [[nodiscard]] static bool is_trait() = delete;
 
     static void set_descriptor(Descriptor descriptor_a)
     {
         xmcu::bit::flag::set(&(RCC->PLLCFGR), RCC_PLLCFGR_PLLM, (descriptor_a.m - 1u) << RCC_PLLCFGR_PLLM_Pos);
         xmcu::bit::flag::set(&(RCC->PLLCFGR), RCC_PLLCFGR_PLLN, (descriptor_a.n) << RCC_PLLCFGR_PLLN_Pos);
+        clocks::details::frequency_cache::invalidate();
     }
 
     static void enable()
     {
-        xmcu::bit::flag::set(&(RCC->PLLCFGR), RCC_PLLCFGR_PLLPEN);
+        xmcu::bit::flag::set(&(RCC->CR), RCC_CR_PLLON);
     }
-    static void disble()
+    static void disable()
     {
-        xmcu::bit::flag::clear(&(RCC->PLLCFGR), RCC_PLLCFGR_PLLPEN);
+        xmcu::bit::flag::clear(&(RCC->CR), RCC_CR_PLLON);
     }
 
     [[nodiscard]] static bool is_enabled()
     {
-        return xmcu::bit::flag::is(RCC->PLLCFGR, RCC_PLLCFGR_PLLPEN);
+        return xmcu::bit::flag::is(RCC->CR, RCC_CR_PLLON);
     }
     [[nodiscard]] static bool is_ready()
     {
         return xmcu::bit::flag::is(RCC->CR, RCC_CR_PLLRDY);
     }
+
+private:
+    [[nodiscard]] static std::uint32_t get_vco_frequency_Hz()
+    {
+        std::uint32_t source_Hz = 0u;
+
+        switch (xmcu::bit::flag::get(RCC->PLLCFGR, RCC_PLLCFGR_PLLSRC))
+        {
+            case RCC_PLLCFGR_PLLSRC_0:
+                source_Hz = msi::get_frequency_Hz();
+                break;
+            case RCC_PLLCFGR_PLLSRC_1:
+                source_Hz = hsi16::get_frequency_Hz();
+                break;
+            case RCC_PLLCFGR_PLLSRC_0 | RCC_PLLCFGR_PLLSRC_1:
+                source_Hz = hse::get_frequency_Hz();
+                break;
+        }
+
+        const std::uint32_t m = (xmcu::bit::flag::get(RCC->PLLCFGR, RCC_PLLCFGR_PLLM) >> RCC_PLLCFGR_PLLM_Pos) + 1u;
+        const std::uint32_t n = xmcu::bit::flag::get(RCC->PLLCFGR, RCC_PLLCFGR_PLLN) >> RCC_PLLCFGR_PLLN_Pos;
+
+        return source_Hz / m * n;
+    }
 };
 template<> inline void pll::set_traits<pll::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::hsi16>>()
 {
     assert(false == pll::is_enabled());
     xmcu::bit::flag::set(&(RCC->PLLCFGR), RCC_PLLCFGR_PLLSRC, RCC_PLLCFGR_PLLSRC_1);
+    clocks::details::frequency_cache::invalidate();
 }
 template<> [[nodiscard]] inline bool pll::is_trait<pll::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::hsi16>>()
 {
@@ -198,6 +226,7 @@ template<> inline void pll::set_traits<pll::traits::source<soc::st::arm::m0::u0:
 {
     assert(false == pll::is_enabled());
     xmcu::bit::flag::set(&(RCC->PLLCFGR), RCC_PLLCFGR_PLLSRC, RCC_PLLCFGR_PLLSRC_0);
+    clocks::details::frequency_cache::invalidate();
 }
 template<> [[nodiscard]] inline bool pll::is_trait<pll::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::msi>>()
 {
@@ -208,6 +237,7 @@ template<> inline void pll::set_traits<pll::traits::source<soc::st::arm::m0::u0:
 {
     assert(false == pll::is_enabled());
     xmcu::bit::flag::set(&(RCC->PLLCFGR), RCC_PLLCFGR_PLLSRC, RCC_PLLCFGR_PLLSRC_0 | RCC_PLLCFGR_PLLSRC_1);
+    clocks::details::frequency_cache::invalidate();
 }
 template<> [[nodiscard]] inline bool pll::is_trait<pll::traits::source<soc::st::arm::m0::u0::rm0503::oscillators::hse>>()
 {
@@ -7,94 +7,162 @@
 
 #if XMCU_SOC_ARCH_CORE_FAMILY == m0 && XMCU_SOC_VENDOR_FAMILY == stm32u0 && XMCU_SOC_VENDOR_FAMILY_RM == rm0503
 
+// std
+#include <bit>
+#include <chrono>
+
 // soc
 #include <soc/st/arm/m0/u0/rm0503/peripherals/GPIO/gpio.hpp>
+#include <soc/st/arm/nvic.hpp>
+#include <soc/st/arm/systick.hpp>
 
 namespace {
 using namespace xmcu;
 using namespace soc::st::arm::m0::u0::rm0503::peripherals;
-extern "C" {
-void EXTI0_1_IRQHandler()
+
+struct Line_handler
 {
-    if (0x0u != EXTI->FPR1)
-    {
-        if (true == bit::is(EXTI->FPR1, 0u))
-        {
-            gpio::async::handler::on_fall(0u);
-            bit::set(&(EXTI->FPR1), 0u);
-        }
-        if (true == bit::is(EXTI->FPR1, 1u))
-        {
-            gpio::async::handler::on_fall(1u);
-            bit::set(&(EXTI->FPR1), 1u);
-        }
-    }
+    gpio::async::Line_handler function = nullptr;
+    void* p_context = nullptr;
+};
 
-    if (0x0u != EXTI->RPR1)
-    {
-        if (true == bit::is(EXTI->RPR1, 0u))
-        {
-            gpio::async::handler::on_rise(0u);
-            bit::set(&(EXTI->RPR1), 0u);
-        }
-        if (true == bit::is(EXTI->RPR1, 1u))
-        {
-            gpio::async::handler::on_rise(1u);
-            bit::set(&(EXTI->RPR1), 1u);
-        }
-    }
+Line_handler line_handlers[16];
+
+struct Debounce_line
+{
+    gpio::async::Line_handler function = nullptr;
+    void* p_context = nullptr;
+    std::chrono::steady_clock::duration hold = {};
+    std::chrono::steady_clock::time_point deadline = {};
+    gpio::Level level = gpio::Level::low;
+};
+
+Debounce_line debounce_lines[16];
+volatile std::uint32_t debounce_pending = 0x0u;
+
+gpio::Level sample_line(std::uint32_t line_a)
+{
+    // EXTICR holds the port index, GPIO ports are spaced evenly on IOPORT
+    const std::uint32_t port = (EXTI->EXTICR[line_a >> 2u] >> ((line_a & 0x3u) * 8u)) & 0xFFu;
+    const ll::gpio::Registers* p_port = reinterpret_cast<const ll::gpio::Registers*>(GPIOA_BASE + port * (GPIOB_BASE - GPIOA_BASE));
+
+    return static_cast<gpio::Level>(bit::is(static_cast<std::uint32_t>(static_cast<ll::gpio::IDR::Data>(p_port->idr)), line_a));
 }
-void EXTI2_3_IRQHandler()
+
+template<typename Register_t> std::uint32_t get(const Register_t& register_a)
 {
-    if (0x0u != EXTI->FPR1)
-    {
-        if (true == bit::is(EXTI->FPR1, 2u))
-        {
-            gpio::async::handler::on_fall(2u);
-            bit::set(&(EXTI->FPR1), 2u);
-        }
-        if (true == bit::is(EXTI->FPR1, 3u))
-        {
-            gpio::async::handler::on_fall(3u);
-            bit::set(&(EXTI->FPR1), 3u);
-        }
-    }
+    return static_cast<std::uint32_t>(static_cast<typename Register_t::Data>(register_a));
+}
+
+void save_port(const ll::gpio::Registers* p_port_a, gpio::Snapshot::Port* p_snapshot_a)
+{
+    p_snapshot_a->moder = get(p_port_a->moder);
+    p_snapshot_a->otyper = get(p_port_a->otyper);
+    p_snapshot_a->ospeedr = get(p_port_a->ospeedr);
+    p_snapshot_a->pupdr = get(p_port_a->pupdr);
+    p_snapshot_a->afr[0] = get(p_port_a->afr[0]);
+    p_snapshot_a->afr[1] = get(p_port_a->afr[1]);
+    p_snapshot_a->odr = get(p_port_a->odr);
+}
+void restore_port(ll::gpio::Registers* p_port_a, const gpio::Snapshot::Port& snapshot_a)
+{
+    // output levels first, mode last
+    p_port_a->bsrr = static_cast<ll::gpio::BSRR::Data>(((~snapshot_a.odr & 0xFFFFu) << 16u) | (snapshot_a.odr & 0xFFFFu));
+    p_port_a->ospeedr = static_cast<ll::gpio::OSPEEDR::Data>(snapshot_a.ospeedr);
+    p_port_a->pupdr = static_cast<ll::gpio::PUPDR::Data>(snapshot_a.pupdr);
+    p_port_a->otyper = static_cast<ll::gpio::OTYPER::Data>(snapshot_a.otyper);
+    p_port_a->afr[0] = static_cast<ll::gpio::AFR::Data>(snapshot_a.afr[0]);
+    p_port_a->afr[1] = static_cast<ll::gpio::AFR::Data>(snapshot_a.afr[1]);
+    p_port_a->moder = static_cast<ll::gpio::MODER::Data>(snapshot_a.moder);
+}
+void set_port_analog(ll::gpio::Registers* p_port_a, std::uint16_t keep_a)
+{
+    // one bit per pin -> two bits per pin
+    std::uint32_t keep = keep_a;
+    keep = (keep | (keep << 8u)) & 0x00FF00FFu;
+    keep = (keep | (keep << 4u)) & 0x0F0F0F0Fu;
+    keep = (keep | (keep << 2u)) & 0x33333333u;
+    keep = (keep | (keep << 1u)) & 0x55555555u;
+    keep *= 0x3u;
+
+    p_port_a->pupdr = static_cast<ll::gpio::PUPDR::Data>(get(p_port_a->pupdr) & keep);
+    p_port_a->moder = static_cast<ll::gpio::MODER::Data>(get(p_port_a->moder) | ~keep);
+}
 
-    if (0x0u != EXTI->RPR1)
+void debounce_edge(std::uint32_t line_a, gpio::Edge, void*)
+{
+    bit::clear(&(EXTI->IMR1), line_a);
+    debounce_lines[line_a].deadline = std::chrono::steady_clock::now() + debounce_lines[line_a].hold;
+
+    Scoped_guard<soc::st::arm::nvic> guard;
+    debounce_pending = debounce_pending | (0x1u << line_a);
+}
+
+void exti_isr_handler(std::uint32_t lines_a)
+{
+    const std::uint32_t falling = EXTI->FPR1 & lines_a;
+    const std::uint32_t rising = EXTI->RPR1 & lines_a;
+
+    // clear before dispatch, edges arriving in the handler stay pending
+    EXTI->FPR1 = falling;
+    EXTI->RPR1 = rising;
+
+    std::uint32_t pending = falling | rising;
+
+    while (0x0u != pending)
     {
-        if (true == bit::is(EXTI->RPR1, 2u))
+        const std::uint32_t line = static_cast<std::uint32_t>(std::countr_zero(pending));
+        const std::uint32_t mask = 0x1u << line;
+        pending &= ~mask;
+
+        if (nullptr != line_handlers[line].function)
         {
-            gpio::async::handler::on_rise(2u);
-            bit::set(&(EXTI->RPR1), 2u);
+            gpio::Edge edge = static_cast<gpio::Edge>(0x0u);
+
+            if (0x0u != (falling & mask))
+            {
+                edge = edge | gpio::Edge::falling;
+            }
+            if (0x0u != (rising & mask))
+            {
+                edge = edge | gpio::Edge::rising;
+            }
+
+            line_handlers[line].function(line, edge, line_handlers[line].p_context);
         }
-        if (true == bit::is(EXTI->RPR1, 3u))
+        else
         {
-            gpio::async::handler::on_rise(3u);
-            bit::set(&(EXTI->RPR1), 3u);
+            if (0x0u != (falling & mask))
+            {
+                gpio::async::handler::on_fall(line);
+            }
+            if (0x0u != (rising & mask))
+            {
+                gpio::async::handler::on_rise(line);
+            }
         }
     }
 }
+} // namespace
+
+extern "C" {
+void EXTI0_1_IRQHandler()
+{
+    exti_isr_handler(0x0003u);
+}
+void EXTI2_3_IRQHandler()
+{
+    exti_isr_handler(0x000Cu);
+}
 void EXTI4_15_IRQHandler()
 {
-    for (std::uint32_t i = 4; i <= 15; i++)
-    {
-        if (true == bit::is(EXTI->FPR1, i))
-        {
-            gpio::async::handler::on_fall(i);
-            bit::set(&(EXTI->FPR1), i);
-        }
-        if (true == bit::is(EXTI->RPR1, i))
-        {
-            gpio::async::handler::on_rise(i);
-            bit::set(&(EXTI->RPR1), i);
-        }
-    }
+    exti_isr_handler(0xFFF0u);
 }
 }
-} // namespace
 
 namespace soc::st::arm::m0::u0::rm0503::peripherals {
 using namespace xmcu;
+using namespace soc::st::arm;
 
 void gpio::configure_pin(ll::gpio::Registers* p_port_a, std::uint32_t pin_a, const gpio::Descriptor<gpio::Mode::out>& desc_a)
 {
@@ -134,6 +202,113 @@ void gpio::configure_pin(ll::gpio::Registers* p_port_a,
     bit::flag::set(&(p_port_a->moder), ll::gpio::MODER::mask << pin_a, ll::gpio::MODER::af << pin_a);
 }
 
+gpio::Snapshot gpio::get_snapshot()
+{
+    Snapshot snapshot;
+    snapshot.enabled_ports = RCC->IOPENR;
+
+#if defined XMCU_GPIOA_PRESENT
+    if (true == bit::flag::is(snapshot.enabled_ports, RCC_IOPENR_GPIOAEN))
+    {
+        save_port(ll::gpio::registers<gpio::A>(), &(snapshot.a));
+    }
+#endif
+#if defined XMCU_GPIOB_PRESENT
+    if (true == bit::flag::is(snapshot.enabled_ports, RCC_IOPENR_GPIOBEN))
+    {
+        save_port(ll::gpio::registers<gpio::B>(), &(snapshot.b));
+    }
+#endif
+#if defined XMCU_GPIOC_PRESENT
+    if (true == bit::flag::is(snapshot.enabled_ports, RCC_IOPENR_GPIOCEN))
+    {
+        save_port(ll::gpio::registers<gpio::C>(), &(snapshot.c));
+    }
+#endif
+#if defined XMCU_GPIOD_PRESENT
+    if (true == bit::flag::is(snapshot.enabled_ports, RCC_IOPENR_GPIODEN))
+    {
+        save_port(ll::gpio::registers<gpio::D>(), &(snapshot.d));
+    }
+#endif
+#if defined XMCU_GPIOF_PRESENT
+    if (true == bit::flag::is(snapshot.enabled_ports, RCC_IOPENR_GPIOFEN))
+    {
+        save_port(ll::gpio::registers<gpio::F>(), &(snapshot.f));
+    }
+#endif
+
+    return snapshot;
+}
+void gpio::set_snapshot(const Snapshot& snapshot_a)
+{
+#if defined XMCU_GPIOA_PRESENT
+    if (true == bit::flag::is(snapshot_a.enabled_ports, RCC_IOPENR_GPIOAEN))
+    {
+        restore_port(ll::gpio::registers<gpio::A>(), snapshot_a.a);
+    }
+#endif
+#if defined XMCU_GPIOB_PRESENT
+    if (true == bit::flag::is(snapshot_a.enabled_ports, RCC_IOPENR_GPIOBEN))
+    {
+        restore_port(ll::gpio::registers<gpio::B>(), snapshot_a.b);
+    }
+#endif
+#if defined XMCU_GPIOC_PRESENT
+    if (true == bit::flag::is(snapshot_a.enabled_ports, RCC_IOPENR_GPIOCEN))
+    {
+        restore_port(ll::gpio::registers<gpio::C>(), snapshot_a.c);
+    }
+#endif
+#if defined XMCU_GPIOD_PRESENT
+    if (true == bit::flag::is(snapshot_a.enabled_ports, RCC_IOPENR_GPIODEN))
+    {
+        restore_port(ll::gpio::registers<gpio::D>(), snapshot_a.d);
+    }
+#endif
+#if defined XMCU_GPIOF_PRESENT
+    if (true == bit::flag::is(snapshot_a.enabled_ports, RCC_IOPENR_GPIOFEN))
+    {
+        restore_port(ll::gpio::registers<gpio::F>(), snapshot_a.f);
+    }
+#endif
+}
+void gpio::set_analog(const Pin_masks& keep_a)
+{
+    const std::uint32_t enabled_ports = RCC->IOPENR;
+
+#if defined XMCU_GPIOA_PRESENT
+    if (true == bit::flag::is(enabled_ports, RCC_IOPENR_GPIOAEN))
+    {
+        set_port_analog(ll::gpio::registers<gpio::A>(), keep_a.a);
+    }
+#endif
+#if defined XMCU_GPIOB_PRESENT
+    if (true == bit::flag::is(enabled_ports, RCC_IOPENR_GPIOBEN))
+    {
+        set_port_analog(ll::gpio::registers<gpio::B>(), keep_a.b);
+    }
+#endif
+#if defined XMCU_GPIOC_PRESENT
+    if (true == bit::flag::is(enabled_ports, RCC_IOPENR_GPIOCEN))
+    {
+        set_port_analog(ll::gpio::registers<gpio::C>(), keep_a.c);
+    }
+#endif
+#if defined XMCU_GPIOD_PRESENT
+    if (true == bit::flag::is(enabled_ports, RCC_IOPENR_GPIODEN))
+    {
+        set_port_analog(ll::gpio::registers<gpio::D>(), keep_a.d);
+    }
+#endif
+#if defined XMCU_GPIOF_PRESENT
+    if (true == bit::flag::is(enabled_ports, RCC_IOPENR_GPIOFEN))
+    {
+        set_port_analog(ll::gpio::registers<gpio::F>(), keep_a.f);
+    }
+#endif
+}
+
 void gpio::async::enable(const IRQ_priority& priority_a)
 {
     NVIC_EnableIRQ(IRQn_Type::EXTI0_1_IRQn);
@@ -152,6 +327,136 @@ void gpio::async::disable()
     NVIC_DisableIRQ(IRQn_Type::EXTI2_3_IRQn);
     NVIC_DisableIRQ(IRQn_Type::EXTI4_15_IRQn);
 }
+void gpio::async::register_line_handler(xmcu::Limited<std::uint32_t, 0u, 15u> line_a, Line_handler handler_a, void* p_context_a)
+{
+    assert(nullptr != handler_a);
+
+    Scoped_guard<nvic> guard;
+    line_handlers[line_a].function = handler_a;
+    line_handlers[line_a].p_context = p_context_a;
+}
+void gpio::async::unregister_line_handler(xmcu::Limited<std::uint32_t, 0u, 15u> line_a)
+{
+    Scoped_guard<nvic> guard;
+    line_handlers[line_a].function = nullptr;
+    line_handlers[line_a].p_context = nullptr;
+}
+
+void gpio::async::debounce::start(xmcu::Limited<std::uint32_t, 0u, 15u> line_a,
+                                  std::chrono::milliseconds hold_a,
+                                  Line_handler handler_a,
+                                  void* p_context_a)
+{
+    assert(nullptr != handler_a);
+    assert(hold_a.count() > 0);
+
+    debounce_lines[line_a] = { .function = handler_a,
+                               .p_context = p_context_a,
+                               .hold = std::chrono::duration_cast<std::chrono::steady_clock::duration>(hold_a),
+                               .deadline = {},
+                               .level = sample_line(line_a) };
+
+    gpio::async::register_line_handler(line_a, debounce_edge, nullptr);
+}
+void gpio::async::debounce::stop(xmcu::Limited<std::uint32_t, 0u, 15u> line_a)
+{
+    gpio::async::unregister_line_handler(line_a);
+
+    Scoped_guard<nvic> guard;
+
+    if (0x0u != (debounce_pending & (0x1u << line_a)))
+    {
+        debounce_pending = debounce_pending & ~(0x1u << line_a);
+        bit::set(&(EXTI->IMR1), line_a);
+    }
+}
+void gpio::async::debounce::update()
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    std::uint32_t pending = debounce_pending;
+
+    while (0x0u != pending)
+    {
+        const std::uint32_t line = static_cast<std::uint32_t>(std::countr_zero(pending));
+        const std::uint32_t mask = 0x1u << line;
+        pending &= ~mask;
+
+        Debounce_line& entry = debounce_lines[line];
+
+        if (now >= entry.deadline)
+        {
+            {
+                Scoped_guard<nvic> guard;
+                debounce_pending = debounce_pending & ~mask;
+            }
+
+            // edges from here on start a new hold period
+            EXTI->FPR1 = mask;
+            EXTI->RPR1 = mask;
+            bit::set(&(EXTI->IMR1), line);
+
+            const Level level = sample_line(line);
+
+            if (level != entry.level)
+            {
+                entry.level = level;
+                entry.function(line, Level::high == level ? Edge::rising : Edge::falling, entry.p_context);
+            }
+        }
+    }
+}
+
+void gpio::async::capture::set_buffer(std::span<Entry> buffer_a)
+{
+    assert(buffer_a.size() > 0u && true == std::has_single_bit(buffer_a.size()));
+
+    Scoped_guard<nvic> guard;
+
+    capture::p_buffer = buffer_a.data();
+    capture::mask = static_cast<std::uint32_t>(buffer_a.size()) - 1u;
+    capture::head = 0x0u;
+    capture::tail = 0x0u;
+    capture::dropped = 0x0u;
+}
+void gpio::async::capture::start(xmcu::Limited<std::uint32_t, 0u, 15u> line_a)
+{
+    assert(nullptr != capture::p_buffer);
+    assert(true == systick::create()->get_view<systick::Tick_counter<api::traits::async>>()->is_started());
+
+    gpio::async::register_line_handler(line_a, capture::on_edge, nullptr);
+}
+void gpio::async::capture::stop(xmcu::Limited<std::uint32_t, 0u, 15u> line_a)
+{
+    gpio::async::unregister_line_handler(line_a);
+}
+gpio::async::capture::Batch gpio::async::capture::get_batch()
+{
+    const std::uint32_t first = capture::tail;
+    const std::uint32_t count = capture::head - first;
+
+    // entries up to head are complete
+    __DMB();
+
+    return { first, count };
+}
+void gpio::async::capture::on_edge(std::uint32_t line_a, Edge edge_a, void*)
+{
+    const std::uint32_t timestamp = systick::create()->get_view<systick::Tick_counter<api::traits::async>>()->get_timestamp();
+    const std::uint32_t index = capture::head;
+
+    if (index - capture::tail > capture::mask)
+    {
+        capture::dropped = capture::dropped + 1u;
+        return;
+    }
+
+    capture::p_buffer[index & capture::mask] = { .timestamp = timestamp, .line = line_a, .edge = edge_a };
+
+    // publish the entry before moving head
+    __DMB();
+    capture::head = index + 1u;
+}
 
 bool gpio::is_irq_slot_enabled(std::uint32_t port_a, xmcu::Limited<std::uint32_t, 0u, 15u> pin_a)
 {
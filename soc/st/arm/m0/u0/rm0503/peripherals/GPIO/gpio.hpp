@@ -8,13 +8,18 @@
  */
 
 // std
+#include <bit>
 #include <cassert>
+#include <chrono>
+#include <span>
+#include <type_traits>
 
 // CMSIS
 #include <stm32u0xx.h>
 
 // xmcu
 #include <xmcu/Limited.hpp>
+#include <xmcu/Scoped_guard.hpp>
 #include <xmcu/bit.hpp>
 #include <xmcu/non_constructible.hpp>
 #include <xmcu/non_copyable.hpp>
@@ -23,6 +28,7 @@
 // soc
 #include <soc/st/arm/IRQ_priority.hpp>
 #include <soc/st/arm/api.hpp>
+#include <soc/st/arm/nvic.hpp>
 #include <soc/st/arm/m0/u0/rm0503/peripherals/GPIO/base.hpp>
 #include <soc/st/arm/m0/u0/rm0503/peripherals/GPIO/gpio_ll.hpp>
 
@@ -110,11 +116,587 @@ struct gpio : public gpio_base
         friend gpio;
     };
 
+    template<auto pin_t> struct Static_pad
+    {
+        using Port = std::remove_cv_t<decltype(pin_t)>;
+        constexpr static Port pin = pin_t;
+
+        [[nodiscard]] static Level read()
+        {
+            return static_cast<Level>(gpio::read(ll::gpio::registers<Port>(), static_cast<std::uint32_t>(pin_t)));
+        }
+        static void write(Level level_a)
+        {
+            gpio::write(ll::gpio::registers<Port>(), static_cast<std::uint32_t>(pin_t), static_cast<ll::gpio::ODR::Flag>(level_a));
+        }
+        static void toggle()
+        {
+            gpio::toggle(ll::gpio::registers<Port>(), static_cast<std::uint32_t>(pin_t));
+        }
+    };
+
+    // every bit is an active phase followed by an idle phase, MSB first
+    template<auto pin_t> class Bit_bang : private xmcu::non_copyable
+    {
+    public:
+        using Port = std::remove_cv_t<decltype(pin_t)>;
+
+        struct Symbol
+        {
+            std::uint32_t active_ns = 0u;
+            std::uint32_t idle_ns = 0u;
+        };
+        struct Descriptor
+        {
+            Level idle_level = Level::low;
+            Symbol zero;
+            Symbol one;
+        };
+
+        // sysclk_Hz_a: clocks::sysclk::get_frequency_Hz(), call set_descriptor again after every sysclk change
+        constexpr Bit_bang(const Descriptor& descriptor_a, std::uint32_t sysclk_Hz_a)
+        {
+            this->set_descriptor(descriptor_a, sysclk_Hz_a);
+        }
+
+        constexpr void set_descriptor(const Descriptor& descriptor_a, std::uint32_t sysclk_Hz_a)
+        {
+            const std::uint32_t set = 0x1u << static_cast<std::uint32_t>(pin_t);
+            const std::uint32_t reset = set << 16u;
+
+            this->active_bsrr = Level::low == descriptor_a.idle_level ? set : reset;
+            this->idle_bsrr = Level::low == descriptor_a.idle_level ? reset : set;
+            this->zero_active_loops = get_loops(descriptor_a.zero.active_ns, sysclk_Hz_a);
+            this->zero_idle_loops = get_loops(descriptor_a.zero.idle_ns, sysclk_Hz_a);
+            this->one_active_loops = get_loops(descriptor_a.one.active_ns, sysclk_Hz_a);
+            this->one_idle_loops = get_loops(descriptor_a.one.idle_ns, sysclk_Hz_a);
+        }
+
+        void write(std::span<const std::uint8_t> data_a, bool mask_irq_a = true) const
+        {
+            if (true == mask_irq_a)
+            {
+                xmcu::Scoped_guard<nvic> guard;
+                this->transmit(data_a);
+            }
+            else
+            {
+                this->transmit(data_a);
+            }
+        }
+
+    private:
+        // "subs; bne" takes 3 cycles per iteration, the store and symbol selection ~6 cycles per phase
+        constexpr static std::uint32_t cycles_per_loop = 3u;
+        constexpr static std::uint32_t phase_overhead_cycles = 6u;
+
+        constexpr static std::uint32_t get_loops(std::uint32_t time_ns_a, std::uint32_t sysclk_Hz_a)
+        {
+            const std::uint64_t cycles = (static_cast<std::uint64_t>(time_ns_a) * sysclk_Hz_a + 999'999'999u) / 1'000'000'000u;
+
+            if (cycles <= phase_overhead_cycles + cycles_per_loop)
+            {
+                return 1u;
+            }
+
+            return static_cast<std::uint32_t>((cycles - phase_overhead_cycles + cycles_per_loop - 1u) / cycles_per_loop);
+        }
+        static void delay(std::uint32_t loops_a)
+        {
+            __ASM volatile("1: subs %0, %0, #1\n"
+                           "   bne 1b\n"
+                           : "+l"(loops_a)
+                           :
+                           : "cc");
+        }
+
+        void transmit(std::span<const std::uint8_t> data_a) const
+        {
+            ll::gpio::Registers* p_port = ll::gpio::registers<Port>();
+
+            for (const std::uint8_t byte : data_a)
+            {
+                for (std::uint32_t mask = 0x80u; 0x0u != mask; mask >>= 1u)
+                {
+                    const bool one = 0x0u != (byte & mask);
+
+                    p_port->bsrr = static_cast<ll::gpio::BSRR::Data>(this->active_bsrr);
+                    delay(true == one ? this->one_active_loops : this->zero_active_loops);
+                    p_port->bsrr = static_cast<ll::gpio::BSRR::Data>(this->idle_bsrr);
+                    delay(true == one ? this->one_idle_loops : this->zero_idle_loops);
+                }
+            }
+        }
+
+        std::uint32_t active_bsrr = 0x0u;
+        std::uint32_t idle_bsrr = 0x0u;
+        std::uint32_t zero_active_loops = 1u;
+        std::uint32_t zero_idle_loops = 1u;
+        std::uint32_t one_active_loops = 1u;
+        std::uint32_t one_idle_loops = 1u;
+    };
+
+    template<auto... pins_t> struct Bus
+    {
+        static_assert(sizeof...(pins_t) > 0u && sizeof...(pins_t) <= 32u, "bus width has to be in range 1..32");
+
+        static void write(std::uint32_t word_a)
+        {
+#if defined XMCU_GPIOA_PRESENT
+            write_port<A>(word_a);
+#endif
+#if defined XMCU_GPIOB_PRESENT
+            write_port<B>(word_a);
+#endif
+#if defined XMCU_GPIOC_PRESENT
+            write_port<C>(word_a);
+#endif
+#if defined XMCU_GPIOD_PRESENT
+            write_port<D>(word_a);
+#endif
+#if defined XMCU_GPIOF_PRESENT
+            write_port<F>(word_a);
+#endif
+        }
+
+        [[nodiscard]] static std::uint32_t read()
+        {
+            std::uint32_t word = 0x0u;
+#if defined XMCU_GPIOA_PRESENT
+            word |= read_port<A>();
+#endif
+#if defined XMCU_GPIOB_PRESENT
+            word |= read_port<B>();
+#endif
+#if defined XMCU_GPIOC_PRESENT
+            word |= read_port<C>();
+#endif
+#if defined XMCU_GPIOD_PRESENT
+            word |= read_port<D>();
+#endif
+#if defined XMCU_GPIOF_PRESENT
+            word |= read_port<F>();
+#endif
+            return word;
+        }
+
+    private:
+        template<typename Port_t, auto pin_t> constexpr static bool is_on_port = std::is_same_v<Port_t, std::remove_cv_t<decltype(pin_t)>>;
+
+        // port pins used by the bus
+        template<typename Port_t> constexpr static std::uint32_t pin_mask = []() {
+            std::uint32_t mask = 0x0u;
+            ((mask |= is_on_port<Port_t, pins_t> ? 0x1u << static_cast<std::uint32_t>(pins_t) : 0x0u), ...);
+            return mask;
+        }();
+        // data bits routed to the port
+        template<typename Port_t> constexpr static std::uint32_t data_mask = []() {
+            std::uint32_t mask = 0x0u;
+            std::uint32_t i = 0u;
+            ((mask |= is_on_port<Port_t, pins_t> ? 0x1u << i : 0x0u, i++), ...);
+            return mask;
+        }();
+        // pin - bit distance
+        template<typename Port_t> constexpr static std::int32_t offset = []() {
+            std::int32_t distance = 0;
+            std::int32_t i = 0;
+            ((distance = is_on_port<Port_t, pins_t> ? static_cast<std::int32_t>(pins_t) - i : distance, i++), ...);
+            return distance;
+        }();
+        // every bit routed to the port keeps the same distance, data can be moved with a single shift
+        template<typename Port_t> constexpr static bool is_linear = []() {
+            bool linear = true;
+            std::int32_t i = 0;
+            ((linear = linear && (false == is_on_port<Port_t, pins_t> || static_cast<std::int32_t>(pins_t) - i == offset<Port_t>),
+              i++),
+             ...);
+            return linear;
+        }();
+
+        template<typename Port_t> constexpr static std::int32_t pin_count = ((is_on_port<Port_t, pins_t> ? 1 : 0) + ...);
+
+        static_assert(
+            ((std::popcount(pin_mask<std::remove_cv_t<decltype(pins_t)>>) == pin_count<std::remove_cv_t<decltype(pins_t)>>) && ...),
+            "pin used more than once");
+
+        template<typename Port_t> static std::uint32_t to_port(std::uint32_t word_a)
+        {
+            if constexpr (true == is_linear<Port_t>)
+            {
+                return offset<Port_t> >= 0 ? (word_a & data_mask<Port_t>) << offset<Port_t> :
+                                             (word_a & data_mask<Port_t>) >> -offset<Port_t>;
+            }
+            else
+            {
+                std::uint32_t value = 0x0u;
+                std::uint32_t i = 0u;
+                ((value |= is_on_port<Port_t, pins_t> ? ((word_a >> i) & 0x1u) << static_cast<std::uint32_t>(pins_t) : 0x0u, i++), ...);
+                return value;
+            }
+        }
+        template<typename Port_t> static std::uint32_t from_port(std::uint32_t value_a)
+        {
+            if constexpr (true == is_linear<Port_t>)
+            {
+                return offset<Port_t> >= 0 ? (value_a & pin_mask<Port_t>) >> offset<Port_t> :
+                                             (value_a & pin_mask<Port_t>) << -offset<Port_t>;
+            }
+            else
+            {
+                std::uint32_t word = 0x0u;
+                std::uint32_t i = 0u;
+                ((word |= is_on_port<Port_t, pins_t> ? ((value_a >> static_cast<std::uint32_t>(pins_t)) & 0x1u) << i : 0x0u, i++), ...);
+                return word;
+            }
+        }
+
+        template<typename Port_t> static void write_port(std::uint32_t word_a)
+        {
+            if constexpr (0x0u != pin_mask<Port_t>)
+            {
+                const std::uint32_t set = to_port<Port_t>(word_a);
+                ll::gpio::registers<Port_t>()->bsrr = static_cast<ll::gpio::BSRR::Data>(((pin_mask<Port_t> & ~set) << 16u) | set);
+            }
+        }
+        template<typename Port_t> static std::uint32_t read_port()
+        {
+            if constexpr (0x0u != pin_mask<Port_t>)
+            {
+                return from_port<Port_t>(static_cast<std::uint32_t>(static_cast<ll::gpio::IDR::Data>(ll::gpio::registers<Port_t>()->idr)));
+            }
+            else
+            {
+                return 0x0u;
+            }
+        }
+    };
+
+    template<auto pin_t, auto descriptor_t, std::uint32_t function_t = 0x0u> struct Pin_descriptor
+    {
+        static_assert(function_t <= 0xFu, "incorrect alternate function");
+
+        using Port = std::remove_cv_t<decltype(pin_t)>;
+
+        constexpr static std::uint32_t pin = static_cast<std::uint32_t>(pin_t);
+        constexpr static Mode mode = []<Mode mode_t>(const Descriptor<mode_t>&) { return mode_t; }(descriptor_t);
+        constexpr static bool is_output_stage = Mode::out == mode || Mode::alternate == mode;
+
+        constexpr static std::uint32_t moder_mask = ll::gpio_moder_descriptor::mask << (pin * 2u);
+        constexpr static std::uint32_t moder_value = static_cast<std::uint32_t>(mode) << (pin * 2u);
+        constexpr static std::uint32_t pupdr_mask = ll::gpio_pupdr_descriptor::mask << (pin * 2u);
+        constexpr static std::uint32_t pupdr_value = static_cast<std::uint32_t>(descriptor_t.pull) << (pin * 2u);
+        constexpr static std::uint32_t otyper_mask = true == is_output_stage ? ll::gpio_otyper_descriptor::mask << pin : 0x0u;
+        constexpr static std::uint32_t otyper_value = []() {
+            if constexpr (true == is_output_stage)
+            {
+                return static_cast<std::uint32_t>(descriptor_t.type) << pin;
+            }
+            return 0x0u;
+        }();
+        constexpr static std::uint32_t ospeedr_mask = true == is_output_stage ? ll::gpio_ospeedr_descriptor::mask << (pin * 2u) : 0x0u;
+        constexpr static std::uint32_t ospeedr_value = []() {
+            if constexpr (true == is_output_stage)
+            {
+                return static_cast<std::uint32_t>(descriptor_t.speed) << (pin * 2u);
+            }
+            return 0x0u;
+        }();
+        constexpr static std::uint32_t afr_index = pin >> 3u;
+        constexpr static std::uint32_t afr_mask[2] = {
+            Mode::alternate == mode && 0u == afr_index ? ll::gpio_afr_descriptor::mask << ((pin & 0x7u) * 4u) : 0x0u,
+            Mode::alternate == mode && 1u == afr_index ? ll::gpio_afr_descriptor::mask << ((pin & 0x7u) * 4u) : 0x0u
+        };
+        constexpr static std::uint32_t afr_value[2] = {
+            Mode::alternate == mode && 0u == afr_index ? function_t << ((pin & 0x7u) * 4u) : 0x0u,
+            Mode::alternate == mode && 1u == afr_index ? function_t << ((pin & 0x7u) * 4u) : 0x0u
+        };
+    };
+
+    template<auto pin_t, Edge edge_t> struct Irq_pin
+    {
+        using Port = std::remove_cv_t<decltype(pin_t)>;
+
+        constexpr static std::uint32_t line = static_cast<std::uint32_t>(pin_t);
+        constexpr static Edge edge = edge_t;
+        constexpr static bool is_rising = 0x0u != (static_cast<std::uint32_t>(edge_t) & static_cast<std::uint32_t>(Edge::rising));
+        constexpr static bool is_falling = 0x0u != (static_cast<std::uint32_t>(edge_t) & static_cast<std::uint32_t>(Edge::falling));
+        // EXTICR port selection
+        constexpr static std::uint32_t port_index = []() {
+#if defined XMCU_GPIOA_PRESENT
+            if constexpr (std::is_same_v<Port, A>) return 0x0u;
+#endif
+#if defined XMCU_GPIOB_PRESENT
+            if constexpr (std::is_same_v<Port, B>) return 0x1u;
+#endif
+#if defined XMCU_GPIOC_PRESENT
+            if constexpr (std::is_same_v<Port, C>) return 0x2u;
+#endif
+#if defined XMCU_GPIOD_PRESENT
+            if constexpr (std::is_same_v<Port, D>) return 0x3u;
+#endif
+#if defined XMCU_GPIOF_PRESENT
+            if constexpr (std::is_same_v<Port, F>) return 0x5u;
+#endif
+            return 0xFFu;
+        }();
+
+        static_assert(0xFFu != port_index, "incorrect port");
+    };
+
+    // EXTI lines owned at compile time, all register values are constants and no RAM is used; lines are not tracked in
+    // enabled_slots, so a line driven by Irq_pins must not be started with Port<..., async>::start (and vice versa)
+    template<typename... irq_pins_t> struct Irq_pins : private xmcu::non_constructible
+    {
+        constexpr static std::uint32_t imr = ((0x1u << irq_pins_t::line) | ...);
+        constexpr static std::uint32_t rtsr = ((true == irq_pins_t::is_rising ? 0x1u << irq_pins_t::line : 0x0u) | ...);
+        constexpr static std::uint32_t ftsr = ((true == irq_pins_t::is_falling ? 0x1u << irq_pins_t::line : 0x0u) | ...);
+
+        constexpr static std::uint32_t exticr_mask[4] = {
+            (((irq_pins_t::line >> 2u) == 0u ? 0xFFu << ((irq_pins_t::line & 0x3u) * 8u) : 0x0u) | ...),
+            (((irq_pins_t::line >> 2u) == 1u ? 0xFFu << ((irq_pins_t::line & 0x3u) * 8u) : 0x0u) | ...),
+            (((irq_pins_t::line >> 2u) == 2u ? 0xFFu << ((irq_pins_t::line & 0x3u) * 8u) : 0x0u) | ...),
+            (((irq_pins_t::line >> 2u) == 3u ? 0xFFu << ((irq_pins_t::line & 0x3u) * 8u) : 0x0u) | ...)
+        };
+        constexpr static std::uint32_t exticr[4] = {
+            (((irq_pins_t::line >> 2u) == 0u ? irq_pins_t::port_index << ((irq_pins_t::line & 0x3u) * 8u) : 0x0u) | ...),
+            (((irq_pins_t::line >> 2u) == 1u ? irq_pins_t::port_index << ((irq_pins_t::line & 0x3u) * 8u) : 0x0u) | ...),
+            (((irq_pins_t::line >> 2u) == 2u ? irq_pins_t::port_index << ((irq_pins_t::line & 0x3u) * 8u) : 0x0u) | ...),
+            (((irq_pins_t::line >> 2u) == 3u ? irq_pins_t::port_index << ((irq_pins_t::line & 0x3u) * 8u) : 0x0u) | ...)
+        };
+
+        static_assert(sizeof...(irq_pins_t) > 0u, "no pins");
+        static_assert(std::popcount(imr) == sizeof...(irq_pins_t), "EXTI line claimed by more than one pin");
+        static_assert(((true == irq_pins_t::is_rising || true == irq_pins_t::is_falling) && ...), "missing edge");
+
+        static void start()
+        {
+            xmcu::Scoped_guard<nvic> guard;
+
+            set_exticr<0u>();
+            set_exticr<1u>();
+            set_exticr<2u>();
+            set_exticr<3u>();
+
+            EXTI->RTSR1 = (EXTI->RTSR1 & ~imr) | rtsr;
+            EXTI->FTSR1 = (EXTI->FTSR1 & ~imr) | ftsr;
+            EXTI->IMR1 = EXTI->IMR1 | imr;
+        }
+        static void stop()
+        {
+            xmcu::Scoped_guard<nvic> guard;
+
+            EXTI->IMR1 = EXTI->IMR1 & ~imr;
+            EXTI->RTSR1 = EXTI->RTSR1 & ~imr;
+            EXTI->FTSR1 = EXTI->FTSR1 & ~imr;
+        }
+
+    private:
+        template<std::uint32_t index_t> static void set_exticr()
+        {
+            if constexpr (0x0u != exticr_mask[index_t])
+            {
+                EXTI->EXTICR[index_t] = (EXTI->EXTICR[index_t] & ~exticr_mask[index_t]) | exticr[index_t];
+            }
+        }
+    };
+
+    // configuration and output state of the ports clocked at capture time
+    struct Snapshot
+    {
+        struct Port
+        {
+            std::uint32_t moder = 0x0u;
+            std::uint32_t otyper = 0x0u;
+            std::uint32_t ospeedr = 0x0u;
+            std::uint32_t pupdr = 0x0u;
+            std::uint32_t afr[2] = { 0x0u, 0x0u };
+            std::uint32_t odr = 0x0u;
+        };
+
+#if defined XMCU_GPIOA_PRESENT
+        Port a;
+#endif
+#if defined XMCU_GPIOB_PRESENT
+        Port b;
+#endif
+#if defined XMCU_GPIOC_PRESENT
+        Port c;
+#endif
+#if defined XMCU_GPIOD_PRESENT
+        Port d;
+#endif
+#if defined XMCU_GPIOF_PRESENT
+        Port f;
+#endif
+        std::uint32_t enabled_ports = 0x0u;
+    };
+    struct Pin_masks
+    {
+#if defined XMCU_GPIOA_PRESENT
+        std::uint16_t a = 0x0u;
+#endif
+#if defined XMCU_GPIOB_PRESENT
+        std::uint16_t b = 0x0u;
+#endif
+#if defined XMCU_GPIOC_PRESENT
+        std::uint16_t c = 0x0u;
+#endif
+#if defined XMCU_GPIOD_PRESENT
+        std::uint16_t d = 0x0u;
+#endif
+#if defined XMCU_GPIOF_PRESENT
+        std::uint16_t f = 0x0u;
+#endif
+    };
+
+    [[nodiscard]] static Snapshot get_snapshot();
+    static void set_snapshot(const Snapshot& snapshot_a);
+    // every pin of the clocked ports goes to analog without pull, except the ones in keep_a
+    static void set_analog(const Pin_masks& keep_a);
+
+    // every register of a port is written once for the whole list
+    template<typename... descriptors_t> static void configure_pins()
+    {
+#if defined XMCU_GPIOA_PRESENT
+        configure_port<A, descriptors_t...>();
+#endif
+#if defined XMCU_GPIOB_PRESENT
+        configure_port<B, descriptors_t...>();
+#endif
+#if defined XMCU_GPIOC_PRESENT
+        configure_port<C, descriptors_t...>();
+#endif
+#if defined XMCU_GPIOD_PRESENT
+        configure_port<D, descriptors_t...>();
+#endif
+#if defined XMCU_GPIOF_PRESENT
+        configure_port<F, descriptors_t...>();
+#endif
+    }
+
     struct async : private xmcu::non_constructible
     {
+        using Line_handler = void (*)(std::uint32_t line_a, Edge edge_a, void* p_context_a);
+
         static void enable(const IRQ_priority& priority_a);
         static void disable();
 
+        // lines without a registered handler are reported through handler::on_rise/on_fall
+        static void register_line_handler(xmcu::Limited<std::uint32_t, 0u, 15u> line_a, Line_handler handler_a, void* p_context_a);
+        static void unregister_line_handler(xmcu::Limited<std::uint32_t, 0u, 15u> line_a);
+
+        // the line is masked in IMR1 on the first edge and re-sampled by the first update() after hold_a elapsed
+        // (std::chrono::steady_clock), handler_a is called once per settled level change
+        struct debounce : private xmcu::non_constructible
+        {
+            static void start(xmcu::Limited<std::uint32_t, 0u, 15u> line_a,
+                              std::chrono::milliseconds hold_a,
+                              Line_handler handler_a,
+                              void* p_context_a);
+            static void stop(xmcu::Limited<std::uint32_t, 0u, 15u> line_a);
+
+            // to be polled (main loop, any periodic interrupt), the call rate only limits the latency
+            static void update();
+        };
+
+        // single producer (EXTI) / single consumer ring of timestamped edges
+        struct capture : private xmcu::non_constructible
+        {
+            struct Entry
+            {
+                std::uint32_t timestamp; // systick input clock cycles, see systick::Tick_counter::get_timestamp
+                std::uint32_t line;
+                Edge edge;
+            };
+
+            // entries logged up to get_batch(), released when the batch goes out of scope
+            class Batch : private xmcu::non_copyable
+            {
+            public:
+                class Iterator
+                {
+                public:
+                    const Entry& operator*() const
+                    {
+                        return capture::p_buffer[this->index & capture::mask];
+                    }
+                    Iterator& operator++()
+                    {
+                        this->index++;
+                        return *this;
+                    }
+                    bool operator!=(const Iterator& other_a) const
+                    {
+                        return this->index != other_a.index;
+                    }
+
+                private:
+                    Iterator(std::uint32_t index_a)
+                        : index(index_a)
+                    {
+                    }
+
+                    std::uint32_t index;
+
+                    friend Batch;
+                };
+
+                Batch(Batch&&) = delete;
+                ~Batch()
+                {
+                    capture::tail = this->first + this->count;
+                }
+
+                Iterator begin() const
+                {
+                    return { this->first };
+                }
+                Iterator end() const
+                {
+                    return { this->first + this->count };
+                }
+                std::uint32_t get_size() const
+                {
+                    return this->count;
+                }
+
+            private:
+                Batch(std::uint32_t first_a, std::uint32_t count_a)
+                    : first(first_a)
+                    , count(count_a)
+                {
+                }
+
+                std::uint32_t first;
+                std::uint32_t count;
+
+                friend capture;
+            };
+
+            // buffer length has to be a power of two
+            static void set_buffer(std::span<Entry> buffer_a);
+
+            // systick::Tick_counter<api::traits::async> has to be started before
+
+            static void start(xmcu::Limited<std::uint32_t, 0u, 15u> line_a);
+            static void stop(xmcu::Limited<std::uint32_t, 0u, 15u> line_a);
+
+            [[nodiscard]] static Batch get_batch();
+            [[nodiscard]] static std::uint32_t get_dropped_count()
+            {
+                return capture::dropped;
+            }
+
+        private:
+            static void on_edge(std::uint32_t line_a, Edge edge_a, void* p_context_a);
+
+            static inline Entry* p_buffer = nullptr;
+            static inline std::uint32_t mask = 0x0u;
+            static inline volatile std::uint32_t head = 0x0u;
+            static inline volatile std::uint32_t tail = 0x0u;
+            static inline volatile std::uint32_t dropped = 0x0u;
+        };
+
         struct handler : private xmcu::non_constructible
         {
             static void on_rise(std::uint32_t pin_a);
@@ -139,11 +721,70 @@ private:
     }
     static void write(ll::gpio::Registers* p_port_a, std::uint32_t pin_a, ll::gpio::ODR::Flag level_a)
     {
-        xmcu::bit::flag::set(&(p_port_a->odr), static_cast<ll::gpio::ODR::Flag>(level_a) << pin_a);
+        p_port_a->bsrr = (ll::gpio::ODR::high == level_a ? ll::gpio::BSRR::high : ll::gpio::BSRR::low) <<
+                         xmcu::Limited<std::uint32_t, 0u, 15u>(pin_a);
+    }
+    static void write(ll::gpio::Registers* p_port_a, std::uint16_t set_mask_a, std::uint16_t reset_mask_a)
+    {
+        p_port_a->bsrr = static_cast<ll::gpio::BSRR::Data>((static_cast<std::uint32_t>(reset_mask_a) << 16u) | set_mask_a);
     }
     static void toggle(ll::gpio::Registers* p_port_a, std::uint32_t pin_a)
     {
-        xmcu::bit::toggle(&(p_port_a->odr), xmcu::Limited<std::uint32_t, 0u, 15u>(pin_a));
+        const std::uint32_t mask = 0x1u << pin_a;
+        const std::uint32_t odr = static_cast<std::uint32_t>(static_cast<ll::gpio::ODR::Data>(p_port_a->odr)) & mask;
+
+        p_port_a->bsrr = static_cast<ll::gpio::BSRR::Data>((odr << 16u) | (odr ^ mask));
+    }
+
+    template<std::uint32_t mask_t, std::uint32_t value_t, std::uint32_t width_mask_t, typename Register_t>
+    static void write_masked(Register_t* p_register_a)
+    {
+        using Data = typename Register_t::Data;
+
+        if constexpr (width_mask_t == mask_t)
+        {
+            *p_register_a = static_cast<Data>(value_t);
+        }
+        else if constexpr (0x0u != mask_t)
+        {
+            *p_register_a = static_cast<Data>((static_cast<std::uint32_t>(static_cast<Data>(*p_register_a)) & ~mask_t) | value_t);
+        }
+    }
+    template<typename Port_t, typename... descriptors_t> static void configure_port()
+    {
+        constexpr std::uint32_t count = ((std::is_same_v<Port_t, typename descriptors_t::Port> ? 1u : 0u) + ...);
+
+        if constexpr (0x0u != count)
+        {
+            constexpr auto on_port = []<typename Descriptor_t>(std::uint32_t value_a) {
+                return true == std::is_same_v<Port_t, typename Descriptor_t::Port> ? value_a : 0x0u;
+            };
+
+            constexpr std::uint32_t moder_mask = (on_port.template operator()<descriptors_t>(descriptors_t::moder_mask) | ...);
+            constexpr std::uint32_t moder_value = (on_port.template operator()<descriptors_t>(descriptors_t::moder_value) | ...);
+            constexpr std::uint32_t pupdr_mask = (on_port.template operator()<descriptors_t>(descriptors_t::pupdr_mask) | ...);
+            constexpr std::uint32_t pupdr_value = (on_port.template operator()<descriptors_t>(descriptors_t::pupdr_value) | ...);
+            constexpr std::uint32_t otyper_mask = (on_port.template operator()<descriptors_t>(descriptors_t::otyper_mask) | ...);
+            constexpr std::uint32_t otyper_value = (on_port.template operator()<descriptors_t>(descriptors_t::otyper_value) | ...);
+            constexpr std::uint32_t ospeedr_mask = (on_port.template operator()<descriptors_t>(descriptors_t::ospeedr_mask) | ...);
+            constexpr std::uint32_t ospeedr_value = (on_port.template operator()<descriptors_t>(descriptors_t::ospeedr_value) | ...);
+            constexpr std::uint32_t afrl_mask = (on_port.template operator()<descriptors_t>(descriptors_t::afr_mask[0]) | ...);
+            constexpr std::uint32_t afrl_value = (on_port.template operator()<descriptors_t>(descriptors_t::afr_value[0]) | ...);
+            constexpr std::uint32_t afrh_mask = (on_port.template operator()<descriptors_t>(descriptors_t::afr_mask[1]) | ...);
+            constexpr std::uint32_t afrh_value = (on_port.template operator()<descriptors_t>(descriptors_t::afr_value[1]) | ...);
+
+            static_assert(std::popcount(moder_mask) == count * 2u, "pin configured more than once");
+
+            ll::gpio::Registers* p_port = ll::gpio::registers<Port_t>();
+
+            // same order as configure_pin, mode switches last
+            write_masked<ospeedr_mask, ospeedr_value, 0xFFFFFFFFu>(&(p_port->ospeedr));
+            write_masked<pupdr_mask, pupdr_value, 0xFFFFFFFFu>(&(p_port->pupdr));
+            write_masked<otyper_mask, otyper_value, 0xFFFFu>(&(p_port->otyper));
+            write_masked<afrl_mask, afrl_value, 0xFFFFFFFFu>(&(p_port->afr[0]));
+            write_masked<afrh_mask, afrh_value, 0xFFFFFFFFu>(&(p_port->afr[1]));
+            write_masked<moder_mask, moder_value, 0xFFFFFFFFu>(&(p_port->moder));
+        }
     }
 
     static bool is_irq_slot_enabled(std::uint32_t port_a, xmcu::Limited<std::uint32_t, 0u, 15u> pin_a);
@@ -179,6 +820,10 @@ public:
     {
         gpio::write(this, static_cast<std::uint32_t>(pin_a), static_cast<ll::gpio::ODR::Flag>(level_a));
     }
+    void write(std::uint16_t set_mask_a, std::uint16_t reset_mask_a)
+    {
+        gpio::write(this, set_mask_a, reset_mask_a);
+    }
     void toggle(Pin pin_a)
     {
         gpio::toggle(this, static_cast<std::uint32_t>(pin_a));
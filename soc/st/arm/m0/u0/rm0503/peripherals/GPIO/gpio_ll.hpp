@@ -17,6 +17,7 @@
 #include <xmcu/non_copyable.hpp>
 
 // soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/peripheral_clock.hpp>
 #include <soc/st/arm/m0/u0/rm0503/peripherals/GPIO/base.hpp>
 
 namespace soc::st::arm::m0::u0::rm0503::peripherals::ll {
@@ -781,7 +782,7 @@ constexpr bool operator!=(gpio::BSRR::Data left_a, std::uint32_t right_a)
 }
 constexpr gpio::BSRR::Data operator<<(gpio::BSRR::Flag left_a, xmcu::Limited<std::uint32_t, 0u, 15u> pin_a)
 {
-    return static_cast<gpio::BSRR::Data>(0x1u << (pin_a * static_cast<std::uint32_t>(left_a)));
+    return static_cast<gpio::BSRR::Data>(0x1u << (pin_a + (gpio::BSRR::low == left_a ? 16u : 0u)));
 }
 constexpr gpio::BSRR::Data operator|(gpio::BSRR::Data left_a, gpio::BSRR::Data right_a)
 {
@@ -966,11 +967,11 @@ template<> [[nodiscard]] constexpr gpio::Registers* gpio::registers<gpio::A>()
 
 template<> inline void gpio_clock::enable<gpio::A>()
 {
-    xmcu::bit::flag::set(&(RCC->IOPENR), RCC_IOPENR_GPIOAEN);
+    clocks::peripheral_clock::acquire<clocks::peripheral_clock::Bus::iop, RCC_IOPENR_GPIOAEN>();
 }
 template<> inline void gpio_clock::disable<gpio::A>()
 {
-    xmcu::bit::flag::clear(&(RCC->IOPENR), RCC_IOPENR_GPIOAEN);
+    clocks::peripheral_clock::release<clocks::peripheral_clock::Bus::iop, RCC_IOPENR_GPIOAEN>();
 }
 template<> inline bool gpio_clock::is_enabled<gpio::A>()
 {
@@ -1080,7 +1081,7 @@ constexpr gpio::ODR::Data operator<<(gpio::ODR::Mask left_a, gpio::A pin_a)
 // BSRR
 constexpr gpio::BSRR::Data operator<<(gpio::BSRR::Flag left_a, gpio::A pin_a)
 {
-    return static_cast<gpio::BSRR::Data>(0x1u << (static_cast<std::uint32_t>(pin_a) * static_cast<std::uint32_t>(left_a)));
+    return static_cast<gpio::BSRR::Data>(0x1u << (static_cast<std::uint32_t>(pin_a) + (gpio::BSRR::low == left_a ? 16u : 0u)));
 }
 
 // LCKR
@@ -1123,11 +1124,11 @@ template<> [[nodiscard]] constexpr gpio::Registers* gpio::registers<gpio::B>()
 
 template<> inline void gpio_clock::enable<gpio::B>()
 {
-    xmcu::bit::flag::set(&(RCC->IOPENR), RCC_IOPENR_GPIOBEN);
+    clocks::peripheral_clock::acquire<clocks::peripheral_clock::Bus::iop, RCC_IOPENR_GPIOBEN>();
 }
 template<> inline void gpio_clock::disable<gpio::B>()
 {
-    xmcu::bit::flag::clear(&(RCC->IOPENR), RCC_IOPENR_GPIOBEN);
+    clocks::peripheral_clock::release<clocks::peripheral_clock::Bus::iop, RCC_IOPENR_GPIOBEN>();
 }
 template<> inline bool gpio_clock::is_enabled<gpio::B>()
 {
@@ -1237,7 +1238,7 @@ constexpr gpio::ODR::Data operator<<(gpio::ODR::Mask left_a, gpio::B pin_a)
 // BSRR
 constexpr gpio::BSRR::Data operator<<(gpio::BSRR::Flag left_a, gpio::B pin_a)
 {
-    return static_cast<gpio::BSRR::Data>(0x1u << (static_cast<std::uint32_t>(pin_a) * static_cast<std::uint32_t>(left_a)));
+    return static_cast<gpio::BSRR::Data>(0x1u << (static_cast<std::uint32_t>(pin_a) + (gpio::BSRR::low == left_a ? 16u : 0u)));
 }
 
 // LCKR
@@ -1280,11 +1281,11 @@ template<> [[nodiscard]] constexpr gpio::Registers* gpio::registers<gpio::C>()
 
 template<> inline void gpio_clock::enable<gpio::C>()
 {
-    xmcu::bit::flag::set(&(RCC->IOPENR), RCC_IOPENR_GPIOCEN);
+    clocks::peripheral_clock::acquire<clocks::peripheral_clock::Bus::iop, RCC_IOPENR_GPIOCEN>();
 }
 template<> inline void gpio_clock::disable<gpio::C>()
 {
-    xmcu::bit::flag::clear(&(RCC->IOPENR), RCC_IOPENR_GPIOCEN);
+    clocks::peripheral_clock::release<clocks::peripheral_clock::Bus::iop, RCC_IOPENR_GPIOCEN>();
 }
 template<> inline bool gpio_clock::is_enabled<gpio::C>()
 {
@@ -1394,7 +1395,7 @@ constexpr gpio::ODR::Data operator<<(gpio::ODR::Mask left_a, gpio::C pin_a)
 // BSRR
 constexpr gpio::BSRR::Data operator<<(gpio::BSRR::Flag left_a, gpio::C pin_a)
 {
-    return static_cast<gpio::BSRR::Data>(0x1u << (static_cast<std::uint32_t>(pin_a) * static_cast<std::uint32_t>(left_a)));
+    return static_cast<gpio::BSRR::Data>(0x1u << (static_cast<std::uint32_t>(pin_a) + (gpio::BSRR::low == left_a ? 16u : 0u)));
 }
 
 // LCKR
@@ -1437,11 +1438,11 @@ template<> [[nodiscard]] constexpr gpio::Registers* gpio::registers<gpio::D>()
 
 template<> inline void gpio_clock::enable<gpio::D>()
 {
-    xmcu::bit::flag::set(&(RCC->IOPENR), RCC_IOPENR_GPIODEN);
+    clocks::peripheral_clock::acquire<clocks::peripheral_clock::Bus::iop, RCC_IOPENR_GPIODEN>();
 }
 template<> inline void gpio_clock::disable<gpio::D>()
 {
-    xmcu::bit::flag::clear(&(RCC->IOPENR), RCC_IOPENR_GPIODEN);
+    clocks::peripheral_clock::release<clocks::peripheral_clock::Bus::iop, RCC_IOPENR_GPIODEN>();
 }
 template<> inline bool gpio_clock::is_enabled<gpio::D>()
 {
@@ -1551,7 +1552,7 @@ constexpr gpio::ODR::Data operator<<(gpio::ODR::Mask left_a, gpio::D pin_a)
 // BSRR
 constexpr gpio::BSRR::Data operator<<(gpio::BSRR::Flag left_a, gpio::D pin_a)
 {
-    return static_cast<gpio::BSRR::Data>(0x1u << (static_cast<std::uint32_t>(pin_a) * static_cast<std::uint32_t>(left_a)));
+    return static_cast<gpio::BSRR::Data>(0x1u << (static_cast<std::uint32_t>(pin_a) + (gpio::BSRR::low == left_a ? 16u : 0u)));
 }
 
 // LCKR
@@ -1594,11 +1595,11 @@ template<> [[nodiscard]] constexpr gpio::Registers* gpio::registers<gpio::F>()
 
 template<> inline void gpio_clock::enable<gpio::F>()
 {
-    xmcu::bit::flag::set(&(RCC->IOPENR), RCC_IOPENR_GPIOFEN);
+    clocks::peripheral_clock::acquire<clocks::peripheral_clock::Bus::iop, RCC_IOPENR_GPIOFEN>();
 }
 template<> inline void gpio_clock::disable<gpio::F>()
 {
-    xmcu::bit::flag::clear(&(RCC->IOPENR), RCC_IOPENR_GPIOFEN);
+    clocks::peripheral_clock::release<clocks::peripheral_clock::Bus::iop, RCC_IOPENR_GPIOFEN>();
 }
 template<> inline bool gpio_clock::is_enabled<gpio::F>()
 {
@@ -1708,7 +1709,7 @@ constexpr gpio::ODR::Data operator<<(gpio::ODR::Mask left_a, gpio::F pin_a)
 // BSRR
 constexpr gpio::BSRR::Data operator<<(gpio::BSRR::Flag left_a, gpio::F pin_a)
 {
-    return static_cast<gpio::BSRR::Data>(0x1u << (static_cast<std::uint32_t>(pin_a) * static_cast<std::uint32_t>(left_a)));
+    return static_cast<gpio::BSRR::Data>(0x1u << (static_cast<std::uint32_t>(pin_a) + (gpio::BSRR::low == left_a ? 16u : 0u)));
 }
 
 // LCKR
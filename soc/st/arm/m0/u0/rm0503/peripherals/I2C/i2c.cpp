@@ -7,10 +7,399 @@
 
 #if XMCU_SOC_ARCH_CORE_FAMILY == m0 && XMCU_SOC_VENDOR_FAMILY == stm32u0 && XMCU_SOC_VENDOR_FAMILY_RM == rm0503
 
+// std
+#include <array>
+
 // soc
 #include <soc/st/arm/m0/u0/rm0503/peripherals/I2C/i2c.hpp>
 
+namespace {
+using namespace soc::st::arm;
+using namespace soc::st::arm::m0::u0::rm0503;
+using namespace soc::st::arm::m0::u0::rm0503::peripherals;
+
+struct Register_map
+{
+    std::span<std::uint8_t> data;
+    std::size_t pointer = 0u;
+    std::size_t begin = 0u;
+    std::size_t length = 0u;
+    bool pointer_received = false;
+
+    // SMBus PEC, the byte received last is held back until the next one shows it wasn't the PEC
+    bool pec = false;
+    std::size_t pec_read_length = 0u;
+    std::uint8_t crc = 0x0u;
+    std::uint8_t held = 0x0u;
+    bool held_received = false;
+    bool pec_loaded = false;
+};
+
+Register_map register_maps[4];
+bool suspended[4] = { false, false, false, false };
+// upper bound for the bus to go idle before a clock change, the transfer is aborted after it
+constexpr std::chrono::milliseconds frequency_scaling_timeout = std::chrono::milliseconds(50);
+
+constexpr auto pec_lut = []() {
+    std::array<std::uint8_t, 256u> lut = {};
+
+    for (std::uint32_t i = 0u; i < lut.size(); i++)
+    {
+        std::uint8_t crc = static_cast<std::uint8_t>(i);
+
+        for (std::uint32_t bit = 0u; bit < 8u; bit++)
+        {
+            crc = static_cast<std::uint8_t>(0x0u != (crc & 0x80u) ? (crc << 1u) ^ 0x07u : crc << 1u);
+        }
+        lut[i] = crc;
+    }
+
+    return lut;
+}();
+
+IRQn_Type select_irq(std::uint32_t base_address_a)
+{
+    switch (base_address_a)
+    {
+#if defined XMCU_I2C1_PRESENT
+        case I2C1_BASE:
+            return I2C1_IRQn;
+#endif
+#if defined XMCU_I2C2_PRESENT
+        case I2C2_BASE:
+            return I2C2_3_4_IRQn;
+#endif
+#if defined XMCU_I2C3_PRESENT
+        case I2C3_BASE:
+            return I2C2_3_4_IRQn;
+#endif
+#if defined XMCU_I2C4_PRESENT
+        case I2C4_BASE:
+            return I2C2_3_4_IRQn;
+#endif
+    }
+
+    assert(false);
+    return static_cast<IRQn_Type>(0xFFFFFFFF);
+}
+
+Register_map* select_register_map(std::uint32_t base_address_a)
+{
+    switch (base_address_a)
+    {
+#if defined XMCU_I2C1_PRESENT
+        case I2C1_BASE:
+            return &(register_maps[0]);
+#endif
+#if defined XMCU_I2C2_PRESENT
+        case I2C2_BASE:
+            return &(register_maps[1]);
+#endif
+#if defined XMCU_I2C3_PRESENT
+        case I2C3_BASE:
+            return &(register_maps[2]);
+#endif
+#if defined XMCU_I2C4_PRESENT
+        case I2C4_BASE:
+            return &(register_maps[3]);
+#endif
+    }
+
+    assert(false);
+    return nullptr;
+}
+
+void store(Register_map* p_map_a, std::uint8_t byte_a)
+{
+    p_map_a->data[p_map_a->pointer++] = byte_a;
+    p_map_a->length++;
+    p_map_a->crc = pec_lut[p_map_a->crc ^ byte_a];
+
+    if (p_map_a->pointer == p_map_a->data.size())
+    {
+        p_map_a->pointer = 0u;
+    }
+}
+
+std::uint32_t select_index(std::uint32_t base_address_a)
+{
+    switch (base_address_a)
+    {
+#if defined XMCU_I2C1_PRESENT
+        case I2C1_BASE:
+            return 0u;
+#endif
+#if defined XMCU_I2C2_PRESENT
+        case I2C2_BASE:
+            return 1u;
+#endif
+#if defined XMCU_I2C3_PRESENT
+        case I2C3_BASE:
+            return 2u;
+#endif
+#if defined XMCU_I2C4_PRESENT
+        case I2C4_BASE:
+            return 3u;
+#endif
+    }
+
+    assert(false);
+    return 0u;
+}
+
+template<i2c::Id id_t> std::uint32_t get_i2c_source_freq_Hz(std::uint32_t sysclk_Hz_a, std::uint32_t pclk_Hz_a)
+{
+    if (true == i2c::clock::is_source_selected<id_t, clocks::sysclk>())
+    {
+        return sysclk_Hz_a;
+    }
+    if (true == i2c::clock::is_source_selected<id_t, clocks::pclk>())
+    {
+        return pclk_Hz_a;
+    }
+    if (true == i2c::clock::is_source_selected<id_t, oscillators::hsi16>())
+    {
+        return oscillators::hsi16::get_frequency_Hz();
+    }
+
+    return 0u;
+}
+
+std::uint32_t get_source_freq_Hz(std::uint32_t base_address_a, std::uint32_t sysclk_Hz_a, std::uint32_t pclk_Hz_a)
+{
+    switch (base_address_a)
+    {
+#if defined XMCU_I2C1_PRESENT
+        case I2C1_BASE:
+            return get_i2c_source_freq_Hz<i2c::_1>(sysclk_Hz_a, pclk_Hz_a);
+#endif
+#if defined XMCU_I2C2_PRESENT
+        case I2C2_BASE:
+            return get_i2c_source_freq_Hz<i2c::_2>(sysclk_Hz_a, pclk_Hz_a);
+#endif
+#if defined XMCU_I2C3_PRESENT
+        case I2C3_BASE:
+            return get_i2c_source_freq_Hz<i2c::_3>(sysclk_Hz_a, pclk_Hz_a);
+#endif
+#if defined XMCU_I2C4_PRESENT
+        case I2C4_BASE:
+            return get_i2c_source_freq_Hz<i2c::_4>(sysclk_Hz_a, pclk_Hz_a);
+#endif
+    }
+
+    assert(false);
+    return 0u;
+}
+
+// tPRESC = (PRESC + 1) / f: PRESC is scaled when the ratio allows it, otherwise every period field is (rounded up)
+std::uint32_t rescale_timing(std::uint32_t timingr_a, std::uint32_t from_Hz_a, std::uint32_t to_Hz_a)
+{
+    const std::uint64_t presc = (((timingr_a & I2C_TIMINGR_PRESC) >> I2C_TIMINGR_PRESC_Pos) + 1u) * to_Hz_a;
+
+    if (0u == presc % from_Hz_a && presc / from_Hz_a >= 1u && presc / from_Hz_a <= 16u)
+    {
+        return (timingr_a & ~I2C_TIMINGR_PRESC) | ((static_cast<std::uint32_t>(presc / from_Hz_a) - 1u) << I2C_TIMINGR_PRESC_Pos);
+    }
+
+    const auto scale = [&](std::uint32_t mask_a, std::uint32_t position_a, std::uint32_t offset_a) {
+        const std::uint64_t cycles = ((timingr_a & mask_a) >> position_a) + offset_a;
+        const std::uint64_t max = (mask_a >> position_a) + offset_a;
+        std::uint64_t scaled = (cycles * to_Hz_a + from_Hz_a - 1u) / from_Hz_a;
+
+        assert(scaled <= max);
+        scaled = scaled > max ? max : (scaled < offset_a ? offset_a : scaled);
+
+        return static_cast<std::uint32_t>(scaled - offset_a) << position_a;
+    };
+
+    return (timingr_a & I2C_TIMINGR_PRESC) | scale(I2C_TIMINGR_SCLDEL, I2C_TIMINGR_SCLDEL_Pos, 1u) |
+           scale(I2C_TIMINGR_SDADEL, I2C_TIMINGR_SDADEL_Pos, 0u) | scale(I2C_TIMINGR_SCLH, I2C_TIMINGR_SCLH_Pos, 1u) |
+           scale(I2C_TIMINGR_SCLL, I2C_TIMINGR_SCLL_Pos, 1u);
+}
+} // namespace
+
+extern "C" {
+using namespace soc::st::arm;
+using namespace soc::st::arm::m0::u0::rm0503::peripherals;
+
+#if defined XMCU_I2C1_PRESENT
+void I2C1_IRQHandler()
+{
+    i2c_slave_isr_handler(reinterpret_cast<i2c::Transceiver<api::traits::async, i2c::slave>*>(I2C1_BASE));
+}
+#endif
+#if defined XMCU_I2C2_PRESENT || defined XMCU_I2C3_PRESENT || defined XMCU_I2C4_PRESENT
+void I2C2_3_4_IRQHandler()
+{
+#if defined XMCU_I2C2_PRESENT
+    if (false == register_maps[1].data.empty())
+    {
+        i2c_slave_isr_handler(reinterpret_cast<i2c::Transceiver<api::traits::async, i2c::slave>*>(I2C2_BASE));
+    }
+#endif
+#if defined XMCU_I2C3_PRESENT
+    if (false == register_maps[2].data.empty())
+    {
+        i2c_slave_isr_handler(reinterpret_cast<i2c::Transceiver<api::traits::async, i2c::slave>*>(I2C3_BASE));
+    }
+#endif
+#if defined XMCU_I2C4_PRESENT
+    if (false == register_maps[3].data.empty())
+    {
+        i2c_slave_isr_handler(reinterpret_cast<i2c::Transceiver<api::traits::async, i2c::slave>*>(I2C4_BASE));
+    }
+#endif
+}
+#endif
+}
+
 namespace soc::st::arm::m0::u0::rm0503::peripherals {
+using namespace xmcu;
+
+void i2c_slave_isr_handler(i2c::Transceiver<api::traits::async, i2c::slave>* p_handler_a)
+{
+    using Transceiver = i2c::Transceiver<api::traits::async, i2c::slave>;
+
+    Register_map* p_map = select_register_map(reinterpret_cast<std::uint32_t>(p_handler_a));
+    const std::uint32_t isr = p_handler_a->isr;
+
+    const i2c::Error errors = static_cast<i2c::Error>(bit::flag::get(isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR));
+
+    if (i2c::Error::none != errors)
+    {
+        bit::flag::set(&(p_handler_a->icr), I2C_ICR_ARLOCF | I2C_ICR_BERRCF | I2C_ICR_OVRCF);
+    }
+
+    if (true == bit::flag::is(isr, I2C_ISR_ADDR))
+    {
+        // repeated start: PEC comes only at the end of the whole transaction, the held byte was data
+        if (true == p_map->held_received)
+        {
+            store(p_map, p_map->held);
+            p_map->held_received = false;
+        }
+
+        if (false == bit::flag::is(p_handler_a->cr1, I2C_CR1_TXIE) && p_map->length > 0u)
+        {
+            Transceiver::handler::on_write(p_map->begin, p_map->length, errors, p_handler_a);
+        }
+
+        p_map->begin = p_map->pointer;
+        p_map->length = 0u;
+        p_map->pec_loaded = false;
+
+        const std::uint8_t address = static_cast<std::uint8_t>((bit::flag::get(isr, I2C_ISR_ADDCODE) >> I2C_ISR_ADDCODE_Pos) << 1u);
+
+        if (true == bit::flag::is(isr, I2C_ISR_DIR))
+        {
+            // read after a command keeps the crc of the write phase
+            p_map->crc = pec_lut[p_map->crc ^ (address | 0x1u)];
+
+            bit::flag::set(&(p_handler_a->isr), I2C_ISR_TXE);
+            bit::flag::set(&(p_handler_a->cr1), I2C_CR1_TXIE);
+        }
+        else
+        {
+            p_map->crc = pec_lut[address];
+            p_map->pointer_received = false;
+        }
+
+        bit::flag::set(&(p_handler_a->icr), I2C_ICR_ADDRCF);
+    }
+
+    if (true == bit::flag::is(isr, I2C_ISR_RXNE))
+    {
+        const std::uint8_t byte = static_cast<std::uint8_t>(p_handler_a->rxdr);
+
+        if (false == p_map->pointer_received)
+        {
+            p_map->pointer = byte < p_map->data.size() ? byte : 0u;
+            p_map->begin = p_map->pointer;
+            p_map->pointer_received = true;
+            p_map->crc = pec_lut[p_map->crc ^ byte];
+        }
+        else if (true == p_map->pec)
+        {
+            if (true == p_map->held_received)
+            {
+                store(p_map, p_map->held);
+            }
+
+            p_map->held = byte;
+            p_map->held_received = true;
+        }
+        else
+        {
+            store(p_map, byte);
+        }
+    }
+
+    if (true == bit::flag::is(isr, I2C_ISR_TXIS) && true == bit::flag::is(p_handler_a->cr1, I2C_CR1_TXIE))
+    {
+        if (true == p_map->pec && p_map->length == p_map->pec_read_length)
+        {
+            // anything the master reads past the PEC is padding
+            p_handler_a->txdr = false == p_map->pec_loaded ? p_map->crc : 0xFFu;
+            p_map->pec_loaded = true;
+        }
+        else
+        {
+            const std::uint8_t byte = p_map->data[p_map->pointer++];
+
+            p_handler_a->txdr = byte;
+            p_map->length++;
+            p_map->crc = pec_lut[p_map->crc ^ byte];
+
+            if (p_map->pointer == p_map->data.size())
+            {
+                p_map->pointer = 0u;
+            }
+        }
+    }
+
+    if (true == bit::flag::is(isr, I2C_ISR_NACKF))
+    {
+        // byte preloaded on TXIS was never sent, the master stopped reading before it
+        if (true == bit::flag::is(p_handler_a->cr1, I2C_CR1_TXIE) && false == bit::flag::is(p_handler_a->isr, I2C_ISR_TXE) &&
+            false == p_map->pec_loaded && p_map->length > 0u)
+        {
+            p_map->pointer = (0u == p_map->pointer ? p_map->data.size() : p_map->pointer) - 1u;
+            p_map->length--;
+
+            bit::flag::set(&(p_handler_a->isr), I2C_ISR_TXE);
+        }
+
+        bit::flag::set(&(p_handler_a->icr), I2C_ICR_NACKCF);
+    }
+
+    if (true == bit::flag::is(isr, I2C_ISR_STOPF) || i2c::Error::none != errors)
+    {
+        const bool master_read = bit::flag::is(p_handler_a->cr1, I2C_CR1_TXIE);
+
+        bit::flag::clear(&(p_handler_a->cr1), I2C_CR1_TXIE);
+        bit::flag::set(&(p_handler_a->icr), I2C_ICR_STOPCF);
+
+        i2c::Error write_errors = errors;
+
+        // data bytes are already in the map, a mismatch is reported only, the application decides whether to drop them
+        if (true == p_map->held_received && i2c::Error::none == errors && p_map->held != p_map->crc)
+        {
+            write_errors = i2c::Error::pec;
+        }
+
+        p_map->held_received = false;
+        p_map->crc = 0x0u;
+
+        if (true == master_read)
+        {
+            Transceiver::handler::on_read(p_map->begin, p_map->length, errors, p_handler_a);
+        }
+        else if (p_map->length > 0u || i2c::Error::none != write_errors)
+        {
+            Transceiver::handler::on_write(p_map->begin, p_map->length, write_errors, p_handler_a);
+        }
+    }
+}
 
 void i2c::Peripheral<i2c::master>::set_descriptor(const i2c::Descriptor<i2c::master>& descriptor_a)
 {
@@ -38,6 +427,56 @@ void i2c::Peripheral<i2c::slave>::set_descriptor(const i2c::Descriptor<i2c::slav
                                                                               ((descriptor_a.address << 1u) & 0x7Fu));
 }
 
+// TIMINGR is writable only with PE cleared, the bus is let go idle before (clearing PE aborts a transfer still running
+// after frequency_scaling_timeout)
+void i2c::on_frequency_scaling(clocks::frequency_scaling::Event event_a,
+                               const clocks::frequency_scaling::Frequencies& from_a,
+                               const clocks::frequency_scaling::Frequencies& to_a,
+                               void* p_context_a)
+{
+    ll::i2c::Peripheral* p_registers = static_cast<ll::i2c::Peripheral*>(p_context_a);
+    const std::uint32_t base_address = reinterpret_cast<std::uint32_t>(p_context_a);
+
+    const std::uint32_t from_Hz = get_source_freq_Hz(base_address, from_a.sysclk_Hz, from_a.pclk_Hz);
+    const std::uint32_t to_Hz = get_source_freq_Hz(base_address, to_a.sysclk_Hz, to_a.pclk_Hz);
+
+    if (from_Hz == to_Hz)
+    {
+        return;
+    }
+
+    switch (event_a)
+    {
+        case clocks::frequency_scaling::Event::prepare: {
+            suspended[select_index(base_address)] = bit::flag::is(p_registers->cr1, I2C_CR1_PE);
+
+            if (true == suspended[select_index(base_address)])
+            {
+                const std::chrono::steady_clock::time_point end_time_point =
+                    std::chrono::steady_clock::now() + frequency_scaling_timeout;
+
+                while (true == bit::flag::is(p_registers->isr, I2C_ISR_BUSY) && std::chrono::steady_clock::now() < end_time_point)
+                    continue;
+                bit::flag::clear(&(p_registers->cr1), I2C_CR1_PE);
+            }
+        }
+        break;
+
+        case clocks::frequency_scaling::Event::complete: {
+            if (0x0u != p_registers->timingr)
+            {
+                p_registers->timingr = rescale_timing(p_registers->timingr, from_Hz, to_Hz);
+            }
+            if (true == suspended[select_index(base_address)])
+            {
+                bit::flag::set(&(p_registers->cr1), I2C_CR1_PE);
+                suspended[select_index(base_address)] = false;
+            }
+        }
+        break;
+    }
+}
+
 __WEAK void
 i2c::Transceiver<api::traits::async, i2c::master>::handler::on_receive(std::uint8_t, Error, Transceiver<api::traits::async, i2c::master>*)
 {
@@ -50,5 +489,293 @@ __WEAK void
 i2c::Transceiver<api::traits::async, i2c::master>::handler::on_event(Event, Error, Transceiver<api::traits::async, i2c::master>*)
 {
 }
+
+std::uint8_t i2c::smbus::get_pec(std::span<const std::uint8_t> data_a, std::uint8_t pec_a)
+{
+    for (std::uint8_t byte : data_a)
+    {
+        pec_a = pec_lut[pec_a ^ byte];
+    }
+
+    return pec_a;
+}
+
+std::pair<std::size_t, i2c::Error> i2c::Transceiver<api::traits::sync, i2c::master>::transmit_pec(std::uint16_t address_a,
+                                                                                                  std::uint8_t command_a,
+                                                                                                  std::span<const std::uint8_t> data_a)
+{
+    assert(data_a.size() <= 253u && false == bit::flag::is(this->cr2, I2C_CR2_ADD10));
+
+    const std::uint8_t header[] = { static_cast<std::uint8_t>(address_a & 0xFEu), command_a };
+    const std::uint8_t pec = smbus::get_pec(data_a, smbus::get_pec(header));
+    const std::size_t length = data_a.size() + 2u;
+
+    bit::flag::set(&(this->icr), I2C_ICR_STOPCF);
+    bit::flag::set(&(this->cr2),
+                   I2C_CR2_SADD | I2C_CR2_NBYTES | I2C_CR2_RD_WRN | I2C_CR2_RELOAD,
+                   (address_a & I2C_CR2_SADD) | (length << I2C_CR2_NBYTES_Pos) | I2C_CR2_AUTOEND | I2C_CR2_START);
+
+    std::size_t i = 0u;
+    while (false == bit::is_any(this->isr, I2C_ISR_NACKF | I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR | I2C_ISR_STOPF))
+    {
+        if (true == bit::flag::is(this->isr, I2C_ISR_TXIS) && i < length)
+        {
+            this->txdr = 0u == i ? command_a : (i <= data_a.size() ? data_a[i - 1u] : pec);
+            i++;
+        }
+    }
+
+    const Error err = static_cast<Error>(this->isr & (I2C_ISR_NACKF | I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR));
+    bit::flag::set(&(this->icr), I2C_ICR_NACKCF | I2C_ICR_ARLOCF | I2C_ICR_BERRCF | I2C_ICR_OVRCF | I2C_ICR_STOPCF);
+
+    const std::size_t transmitted = i > 1u ? i - 1u : 0u;
+    return { transmitted > data_a.size() ? data_a.size() : transmitted, err };
+}
+
+std::pair<std::size_t, i2c::Error> i2c::Transceiver<api::traits::sync, i2c::master>::receive_pec(std::uint16_t address_a,
+                                                                                                 std::uint8_t command_a,
+                                                                                                 std::span<std::uint8_t> data_a)
+{
+    assert(data_a.size() <= 254u && false == bit::flag::is(this->cr2, I2C_CR2_ADD10));
+
+    constexpr std::uint32_t error_mask = I2C_ISR_NACKF | I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR;
+
+    bit::flag::set(&(this->icr), I2C_ICR_STOPCF);
+
+    // command byte, no autoend: the read phase follows after a repeated start
+    bit::flag::set(&(this->cr2),
+                   I2C_CR2_SADD | I2C_CR2_NBYTES | I2C_CR2_RD_WRN | I2C_CR2_AUTOEND | I2C_CR2_RELOAD,
+                   (address_a & I2C_CR2_SADD) | (0x1u << I2C_CR2_NBYTES_Pos) | I2C_CR2_START);
+
+    while (false == bit::is_any(this->isr, error_mask | I2C_ISR_TC))
+    {
+        if (true == bit::flag::is(this->isr, I2C_ISR_TXIS))
+        {
+            this->txdr = command_a;
+        }
+    }
+
+    std::size_t i = 0u;
+    std::uint8_t pec = 0x0u;
+
+    if (false == bit::is_any(this->isr, error_mask))
+    {
+        bit::flag::set(&(this->cr2),
+                       I2C_CR2_NBYTES,
+                       ((data_a.size() + 1u) << I2C_CR2_NBYTES_Pos) | I2C_CR2_RD_WRN | I2C_CR2_AUTOEND | I2C_CR2_START);
+
+        while (false == bit::is_any(this->isr, error_mask | I2C_ISR_STOPF))
+        {
+            if (true == bit::flag::is(this->isr, I2C_ISR_RXNE))
+            {
+                const std::uint8_t byte = static_cast<std::uint8_t>(this->rxdr);
+
+                if (i < data_a.size())
+                {
+                    data_a[i++] = byte;
+                }
+                else
+                {
+                    pec = byte;
+                }
+            }
+        }
+    }
+
+    std::uint32_t err = this->isr & error_mask;
+    bit::flag::set(&(this->icr), I2C_ICR_NACKCF | I2C_ICR_ARLOCF | I2C_ICR_BERRCF | I2C_ICR_OVRCF | I2C_ICR_STOPCF);
+
+    if (0x0u == err)
+    {
+        const std::uint8_t header[] = { static_cast<std::uint8_t>(address_a & 0xFEu),
+                                        command_a,
+                                        static_cast<std::uint8_t>((address_a & 0xFEu) | 0x1u) };
+
+        if (smbus::get_pec(data_a.first(i), smbus::get_pec(header)) != pec)
+        {
+            err = static_cast<std::uint32_t>(Error::pec);
+        }
+    }
+
+    return { i, static_cast<Error>(err) };
+}
+
+std::pair<std::size_t, i2c::Error> i2c::Transceiver<api::traits::sync, i2c::master>::transmit_pec(std::uint16_t address_a,
+                                                                                                  std::uint8_t command_a,
+                                                                                                  std::span<const std::uint8_t> data_a,
+                                                                                                  std::chrono::milliseconds timeout_a)
+{
+    assert(data_a.size() <= 253u && false == bit::flag::is(this->cr2, I2C_CR2_ADD10));
+
+    const std::chrono::steady_clock::time_point end_time_point = std::chrono::steady_clock::now() + timeout_a;
+
+    const std::uint8_t header[] = { static_cast<std::uint8_t>(address_a & 0xFEu), command_a };
+    const std::uint8_t pec = smbus::get_pec(data_a, smbus::get_pec(header));
+    const std::size_t length = data_a.size() + 2u;
+
+    bit::flag::set(&(this->icr), I2C_ICR_STOPCF);
+    bit::flag::set(&(this->cr2),
+                   I2C_CR2_SADD | I2C_CR2_NBYTES | I2C_CR2_RD_WRN | I2C_CR2_RELOAD,
+                   (address_a & I2C_CR2_SADD) | (length << I2C_CR2_NBYTES_Pos) | I2C_CR2_AUTOEND | I2C_CR2_START);
+
+    std::size_t i = 0u;
+    while (false == bit::is_any(this->isr, I2C_ISR_NACKF | I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR | I2C_ISR_STOPF) &&
+           std::chrono::steady_clock::now() < end_time_point)
+    {
+        if (true == bit::flag::is(this->isr, I2C_ISR_TXIS) && i < length)
+        {
+            this->txdr = 0u == i ? command_a : (i <= data_a.size() ? data_a[i - 1u] : pec);
+            i++;
+        }
+    }
+
+    const Error err = static_cast<Error>(this->isr & (I2C_ISR_NACKF | I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR));
+    bit::flag::set(&(this->icr), I2C_ICR_NACKCF | I2C_ICR_ARLOCF | I2C_ICR_BERRCF | I2C_ICR_OVRCF | I2C_ICR_STOPCF);
+
+    const std::size_t transmitted = i > 1u ? i - 1u : 0u;
+    return { transmitted > data_a.size() ? data_a.size() : transmitted, err };
+}
+
+std::pair<std::size_t, i2c::Error> i2c::Transceiver<api::traits::sync, i2c::master>::receive_pec(std::uint16_t address_a,
+                                                                                                 std::uint8_t command_a,
+                                                                                                 std::span<std::uint8_t> data_a,
+                                                                                                 std::chrono::milliseconds timeout_a)
+{
+    assert(data_a.size() <= 254u && false == bit::flag::is(this->cr2, I2C_CR2_ADD10));
+
+    constexpr std::uint32_t error_mask = I2C_ISR_NACKF | I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR;
+    const std::chrono::steady_clock::time_point end_time_point = std::chrono::steady_clock::now() + timeout_a;
+
+    bit::flag::set(&(this->icr), I2C_ICR_STOPCF);
+
+    // command byte, no autoend: the read phase follows after a repeated start
+    bit::flag::set(&(this->cr2),
+                   I2C_CR2_SADD | I2C_CR2_NBYTES | I2C_CR2_RD_WRN | I2C_CR2_AUTOEND | I2C_CR2_RELOAD,
+                   (address_a & I2C_CR2_SADD) | (0x1u << I2C_CR2_NBYTES_Pos) | I2C_CR2_START);
+
+    while (false == bit::is_any(this->isr, error_mask | I2C_ISR_TC) && std::chrono::steady_clock::now() < end_time_point)
+    {
+        if (true == bit::flag::is(this->isr, I2C_ISR_TXIS))
+        {
+            this->txdr = command_a;
+        }
+    }
+
+    std::size_t i = 0u;
+    std::uint8_t pec = 0x0u;
+
+    if (true == bit::flag::is(this->isr, I2C_ISR_TC) && false == bit::is_any(this->isr, error_mask))
+    {
+        bit::flag::set(&(this->cr2),
+                       I2C_CR2_NBYTES,
+                       ((data_a.size() + 1u) << I2C_CR2_NBYTES_Pos) | I2C_CR2_RD_WRN | I2C_CR2_AUTOEND | I2C_CR2_START);
+
+        while (false == bit::is_any(this->isr, error_mask | I2C_ISR_STOPF) && std::chrono::steady_clock::now() < end_time_point)
+        {
+            if (true == bit::flag::is(this->isr, I2C_ISR_RXNE))
+            {
+                const std::uint8_t byte = static_cast<std::uint8_t>(this->rxdr);
+
+                if (i < data_a.size())
+                {
+                    data_a[i++] = byte;
+                }
+                else
+                {
+                    pec = byte;
+                }
+            }
+        }
+    }
+
+    // PEC is verified only for a transfer that ran to its stop condition
+    const bool completed = bit::flag::is(this->isr, I2C_ISR_STOPF);
+    std::uint32_t err = this->isr & error_mask;
+    bit::flag::set(&(this->icr), I2C_ICR_NACKCF | I2C_ICR_ARLOCF | I2C_ICR_BERRCF | I2C_ICR_OVRCF | I2C_ICR_STOPCF);
+
+    if (0x0u == err && true == completed)
+    {
+        const std::uint8_t header[] = { static_cast<std::uint8_t>(address_a & 0xFEu),
+                                        command_a,
+                                        static_cast<std::uint8_t>((address_a & 0xFEu) | 0x1u) };
+
+        if (smbus::get_pec(data_a.first(i), smbus::get_pec(header)) != pec)
+        {
+            err = static_cast<std::uint32_t>(Error::pec);
+        }
+    }
+
+    return { i, static_cast<Error>(err) };
+}
+
+#if 1 == XMCU_ISR_CONTEXT
+void i2c::Transceiver<api::traits::async, i2c::slave>::enable(const IRQ_priority& priority_a, void* p_context_a)
+#endif
+#if 0 == XMCU_ISR_CONTEXT
+    void i2c::Transceiver<api::traits::async, i2c::slave>::enable(const IRQ_priority& priority_a)
+#endif
+{
+    IRQn_Type irq_type = select_irq(reinterpret_cast<std::uint32_t>(this));
+
+    NVIC_EnableIRQ(irq_type);
+    NVIC_SetPriority(irq_type, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), priority_a.preempt_priority, priority_a.sub_priority));
+}
+void i2c::Transceiver<api::traits::async, i2c::slave>::disable()
+{
+    IRQn_Type irq_type = select_irq(reinterpret_cast<std::uint32_t>(this));
+
+    if (I2C2_3_4_IRQn != irq_type || (true == register_maps[1].data.empty() && true == register_maps[2].data.empty() &&
+                                      true == register_maps[3].data.empty()))
+    {
+        NVIC_DisableIRQ(irq_type);
+    }
+}
+
+void i2c::Transceiver<api::traits::async, i2c::slave>::register_map_start(std::span<std::uint8_t> map_a)
+{
+    assert(false == map_a.empty() && map_a.size() <= 256u);
+
+    Register_map* p_map = select_register_map(reinterpret_cast<std::uint32_t>(this));
+
+    p_map->data = map_a;
+    p_map->pointer = 0u;
+    p_map->begin = 0u;
+    p_map->length = 0u;
+    p_map->pointer_received = false;
+    p_map->pec = false;
+    p_map->crc = 0x0u;
+    p_map->held_received = false;
+    p_map->pec_loaded = false;
+
+    bit::flag::set(&(this->icr), I2C_ICR_ADDRCF | I2C_ICR_NACKCF | I2C_ICR_STOPCF | I2C_ICR_ARLOCF | I2C_ICR_BERRCF | I2C_ICR_OVRCF);
+    bit::flag::set(&(this->cr1), I2C_CR1_ADDRIE | I2C_CR1_RXIE | I2C_CR1_NACKIE | I2C_CR1_STOPIE | I2C_CR1_ERRIE);
+}
+void i2c::Transceiver<api::traits::async, i2c::slave>::register_map_start(std::span<std::uint8_t> map_a, const Pec& pec_a)
+{
+    this->register_map_start(map_a);
+
+    Register_map* p_map = select_register_map(reinterpret_cast<std::uint32_t>(this));
+
+    p_map->pec = true;
+    p_map->pec_read_length = pec_a.read_length;
+}
+void i2c::Transceiver<api::traits::async, i2c::slave>::register_map_stop()
+{
+    bit::flag::clear(&(this->cr1), I2C_CR1_ADDRIE | I2C_CR1_RXIE | I2C_CR1_TXIE | I2C_CR1_NACKIE | I2C_CR1_STOPIE | I2C_CR1_ERRIE);
+    select_register_map(reinterpret_cast<std::uint32_t>(this))->data = {};
+}
+
+__WEAK void i2c::Transceiver<api::traits::async, i2c::slave>::handler::on_write(std::size_t,
+                                                                                 std::size_t,
+                                                                                 Error,
+                                                                                 Transceiver<api::traits::async, i2c::slave>*)
+{
+}
+__WEAK void i2c::Transceiver<api::traits::async, i2c::slave>::handler::on_read(std::size_t,
+                                                                                std::size_t,
+                                                                                Error,
+                                                                                Transceiver<api::traits::async, i2c::slave>*)
+{
+}
 } // namespace soc::st::arm::m0::u0::rm0503::peripherals
 #endif
\ No newline at end of file
@@ -9,6 +9,7 @@
 
 // std
 #include <chrono>
+#include <span>
 
 // xmcu
 #include <xmcu/macros.hpp>
@@ -16,6 +17,7 @@
 
 // soc
 #include <soc/st/arm/api.hpp>
+#include <soc/st/arm/m0/u0/rm0503/clocks/frequency_scaling.hpp>
 #include <soc/st/arm/m0/u0/rm0503/clocks/pclk.hpp>
 #include <soc/st/arm/m0/u0/rm0503/clocks/sysclk.hpp>
 #include <soc/st/arm/m0/u0/rm0503/oscillators/hsi16.hpp>
@@ -58,14 +60,14 @@ struct i2c : public i2c_base
         volatile std::uint32_t reserved;
 
     public:
-        volatile std::uint32_t isr;         // interrupt and status register
+        volatile mutable std::uint32_t isr; // interrupt and status register
         volatile mutable std::uint32_t icr; // interrupt clear register
     private:
         volatile std::uint32_t reserved0;
 
     public:
-        volatile std::uint32_t rxdr; // receive data register
-        volatile std::uint32_t txdr; // transmit data register
+        volatile std::uint32_t rxdr;         // receive data register
+        volatile mutable std::uint32_t txdr; // transmit data register
     };
 
     template<i2c::Id id_t> [[nodiscard]] constexpr static Peripheral* peripheral() = delete;
@@ -331,7 +333,8 @@ struct i2c : public i2c_base
         arbitration_lost = I2C_ISR_ARLO,
         frame_misplaced = I2C_ISR_BERR,
         nack = I2C_ISR_NACKF,
-        overrun = I2C_ISR_OVR
+        overrun = I2C_ISR_OVR,
+        pec = 0x800u
     };
     enum class Event : std::uint32_t
     {
@@ -400,10 +403,17 @@ struct i2c : public i2c_base
     {
     };
 
+    struct smbus : private xmcu::non_constructible
+    {
+        [[nodiscard]] static std::uint8_t get_pec(std::span<const std::uint8_t> data_a, std::uint8_t pec_a = 0x0u);
+    };
+
     template<api::traits trait_t, Kind kind_t> class Transceiver : private non_constructible
     {
     };
 
+    template<std::size_t register_count_t> class Device;
+
     template<i2c::Id id_t, Kind kind_t> [[nodiscard]] constexpr static Peripheral<kind_t>* peripheral() = delete;
 
     template<i2c::Id id_t, typename transmission_mode_t> static void set_traits()
@@ -414,6 +424,70 @@ struct i2c : public i2c_base
         detail::sda_pin<id_t, transmission_mode_t::sda_descriptor, transmission_mode_t::sda_pin>::configure();
         detail::scl_pin<id_t, transmission_mode_t::scl_descriptor, transmission_mode_t::scl_pin>::configure();
     }
+
+    template<i2c::Id id_t, typename transmission_mode_t> [[nodiscard]] static bool recover_bus(std::uint32_t bus_frequency_Hz_a = 100000u)
+    {
+        using Sda_port = std::remove_cv_t<decltype(transmission_mode_t::sda_pin)>;
+        using Scl_port = std::remove_cv_t<decltype(transmission_mode_t::scl_pin)>;
+
+        constexpr gpio::Descriptor<gpio::Mode::out> line_descriptor = { .type = gpio::Type::open_drain,
+                                                                        .pull = gpio::Pull::none,
+                                                                        .speed = gpio::Speed::low };
+
+        gpio::Port<Sda_port, api::traits::sync>* p_sda = gpio::port<Sda_port, api::traits::sync>();
+        gpio::Port<Scl_port, api::traits::sync>* p_scl = gpio::port<Scl_port, api::traits::sync>();
+
+        // ~4 cycles per iteration on M0+
+        const std::uint32_t half_period = clocks::sysclk::get_frequency_Hz() / (bus_frequency_Hz_a * 2u * 4u) + 1u;
+        const auto delay = [half_period]() {
+            for (std::uint32_t i = 0u; i < half_period; i++) __NOP();
+        };
+
+        // lines are driven through BSRR directly, recovery doesn't depend on the port's write() semantics
+        constexpr std::uint32_t sda_mask = 0x1u << static_cast<std::uint32_t>(transmission_mode_t::sda_pin);
+        constexpr std::uint32_t scl_mask = 0x1u << static_cast<std::uint32_t>(transmission_mode_t::scl_pin);
+        const auto set_sda = [](gpio::Level level_a) {
+            ll::gpio::registers<Sda_port>()->bsrr =
+                static_cast<ll::gpio::BSRR::Data>(gpio::Level::high == level_a ? sda_mask : sda_mask << 16u);
+        };
+        const auto set_scl = [](gpio::Level level_a) {
+            ll::gpio::registers<Scl_port>()->bsrr =
+                static_cast<ll::gpio::BSRR::Data>(gpio::Level::high == level_a ? scl_mask : scl_mask << 16u);
+        };
+
+        set_sda(gpio::Level::high);
+        set_scl(gpio::Level::high);
+        p_sda->set_pin_descriptor(transmission_mode_t::sda_pin, line_descriptor);
+        p_scl->set_pin_descriptor(transmission_mode_t::scl_pin, line_descriptor);
+        delay();
+
+        for (std::uint32_t i = 0u; i < 9u && gpio::Level::low == p_sda->read(transmission_mode_t::sda_pin); i++)
+        {
+            set_scl(gpio::Level::low);
+            delay();
+            set_scl(gpio::Level::high);
+            delay();
+        }
+
+        // stop condition: sda rising while scl is high
+        set_sda(gpio::Level::low);
+        delay();
+        set_sda(gpio::Level::high);
+        delay();
+
+        const bool released = gpio::Level::high == p_sda->read(transmission_mode_t::sda_pin) &&
+                              gpio::Level::high == p_scl->read(transmission_mode_t::scl_pin);
+
+        set_traits<id_t, transmission_mode_t>();
+
+        return released;
+    }
+
+    // clocks::frequency_scaling handler, p_context_a: i2c::Peripheral<master>* or i2c::Peripheral<slave>*
+    static void on_frequency_scaling(clocks::frequency_scaling::Event event_a,
+                                     const clocks::frequency_scaling::Frequencies& from_a,
+                                     const clocks::frequency_scaling::Frequencies& to_a,
+                                     void* p_context_a);
 };
 
 template<> struct i2c::Descriptor<i2c::master>
@@ -658,6 +732,16 @@ public:
         return { i, err };
     }
 
+    std::pair<std::size_t, i2c::Error>
+    transmit_pec(std::uint16_t address_a, std::uint8_t command_a, std::span<const std::uint8_t> data_a);
+    std::pair<std::size_t, i2c::Error> receive_pec(std::uint16_t address_a, std::uint8_t command_a, std::span<std::uint8_t> data_a);
+    std::pair<std::size_t, i2c::Error> transmit_pec(std::uint16_t address_a,
+                                                    std::uint8_t command_a,
+                                                    std::span<const std::uint8_t> data_a,
+                                                    std::chrono::milliseconds timeout_a);
+    std::pair<std::size_t, i2c::Error>
+    receive_pec(std::uint16_t address_a, std::uint8_t command_a, std::span<std::uint8_t> data_a, std::chrono::milliseconds timeout_a);
+
 private:
     std::uint32_t data_length_mask(std::size_t length_a) const
     {
@@ -667,6 +751,172 @@ private:
 };
 template<> class i2c::Transceiver<api::traits::sync, i2c::slave> : private ll::i2c::Peripheral
 {
+public:
+    std::pair<std::size_t, i2c::Error> transmit(std::span<const std::uint8_t> data_a)
+    {
+        while (false == this->wait_for_address_match(true))
+            continue;
+
+        std::size_t i = 0u;
+        while (false == xmcu::bit::is_any(this->isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR | I2C_ISR_STOPF))
+        {
+            if (true == xmcu::bit::flag::is(this->isr, I2C_ISR_TXIS))
+            {
+                this->txdr = i < data_a.size() ? data_a[i] : 0xFFu;
+                i++;
+            }
+        }
+
+        return { this->get_transmitted_count(i, data_a.size()), this->get_error_and_clear() };
+    }
+    std::pair<std::size_t, i2c::Error> transmit(std::span<const std::uint8_t> data_a, std::chrono::milliseconds timeout_a)
+    {
+        const std::chrono::steady_clock::time_point end_time_point = std::chrono::steady_clock::now() + timeout_a;
+
+        while (false == this->wait_for_address_match(true))
+        {
+            if (std::chrono::steady_clock::now() >= end_time_point)
+            {
+                return { 0u, Error::none };
+            }
+        }
+
+        std::size_t i = 0u;
+        while (false == xmcu::bit::is_any(this->isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR | I2C_ISR_STOPF) &&
+               std::chrono::steady_clock::now() < end_time_point)
+        {
+            if (true == xmcu::bit::flag::is(this->isr, I2C_ISR_TXIS))
+            {
+                this->txdr = i < data_a.size() ? data_a[i] : 0xFFu;
+                i++;
+            }
+        }
+
+        return { this->get_transmitted_count(i, data_a.size()), this->get_error_and_clear() };
+    }
+
+    std::pair<std::size_t, i2c::Error> receive(std::span<std::uint8_t> data_a) const
+    {
+        while (false == this->wait_for_address_match(false))
+            continue;
+
+        std::size_t i = 0u;
+        while (false == xmcu::bit::is_any(this->isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR | I2C_ISR_STOPF))
+        {
+            if (true == xmcu::bit::flag::is(this->isr, I2C_ISR_RXNE))
+            {
+                const std::uint8_t byte = static_cast<std::uint8_t>(this->rxdr);
+
+                if (i < data_a.size())
+                {
+                    data_a[i++] = byte;
+                }
+            }
+        }
+
+        return { i, this->get_error_and_clear() };
+    }
+    std::pair<std::size_t, i2c::Error> receive(std::span<std::uint8_t> data_a, std::chrono::milliseconds timeout_a) const
+    {
+        const std::chrono::steady_clock::time_point end_time_point = std::chrono::steady_clock::now() + timeout_a;
+
+        while (false == this->wait_for_address_match(false))
+        {
+            if (std::chrono::steady_clock::now() >= end_time_point)
+            {
+                return { 0u, Error::none };
+            }
+        }
+
+        std::size_t i = 0u;
+        while (false == xmcu::bit::is_any(this->isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR | I2C_ISR_STOPF) &&
+               std::chrono::steady_clock::now() < end_time_point)
+        {
+            if (true == xmcu::bit::flag::is(this->isr, I2C_ISR_RXNE))
+            {
+                const std::uint8_t byte = static_cast<std::uint8_t>(this->rxdr);
+
+                if (i < data_a.size())
+                {
+                    data_a[i++] = byte;
+                }
+            }
+        }
+
+        return { i, this->get_error_and_clear() };
+    }
+
+private:
+    bool wait_for_address_match(bool master_read_a) const
+    {
+        if (false == xmcu::bit::flag::is(this->isr, I2C_ISR_ADDR))
+        {
+            return false;
+        }
+
+        if (master_read_a != xmcu::bit::flag::is(this->isr, I2C_ISR_DIR))
+        {
+            this->reject_transfer();
+            return false;
+        }
+
+        if (true == master_read_a)
+        {
+            xmcu::bit::flag::set(&(this->isr), I2C_ISR_TXE); // flush byte left in txdr by previous transfer
+        }
+        xmcu::bit::flag::set(&(this->icr), I2C_ICR_ADDRCF);
+
+        return true;
+    }
+
+    // transfer in the other direction would keep SCL stretched: written bytes are NACKed, a read gets 0xFF until the master NACKs
+    void reject_transfer() const
+    {
+        if (true == xmcu::bit::flag::is(this->isr, I2C_ISR_DIR))
+        {
+            xmcu::bit::flag::set(&(this->isr), I2C_ISR_TXE);
+        }
+        else
+        {
+            xmcu::bit::flag::set(&(this->cr2), I2C_CR2_NACK);
+        }
+        xmcu::bit::flag::set(&(this->icr), I2C_ICR_ADDRCF);
+
+        while (false == xmcu::bit::is_any(this->isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_STOPF))
+        {
+            if (true == xmcu::bit::flag::is(this->isr, I2C_ISR_RXNE))
+            {
+                static_cast<void>(this->rxdr);
+                xmcu::bit::flag::set(&(this->cr2), I2C_CR2_NACK);
+            }
+            if (true == xmcu::bit::flag::is(this->isr, I2C_ISR_TXIS))
+            {
+                this->txdr = 0xFFu;
+            }
+        }
+
+        this->get_error_and_clear();
+    }
+
+    // TXIS preloads the next byte before the master ACKs/NACKs the current one, a byte still in TXDR wasn't sent
+    std::size_t get_transmitted_count(std::size_t loaded_a, std::size_t size_a) const
+    {
+        if (loaded_a > 0u && false == xmcu::bit::flag::is(this->isr, I2C_ISR_TXE))
+        {
+            loaded_a--;
+            xmcu::bit::flag::set(&(this->isr), I2C_ISR_TXE);
+        }
+
+        return loaded_a < size_a ? loaded_a : size_a;
+    }
+
+    Error get_error_and_clear() const
+    {
+        const Error err = static_cast<Error>(this->isr & (I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR));
+        xmcu::bit::flag::set(&(this->icr), I2C_ICR_NACKCF | I2C_ICR_ARLOCF | I2C_ICR_BERRCF | I2C_ICR_OVRCF | I2C_ICR_STOPCF);
+
+        return err;
+    }
 };
 
 template<> class i2c::Transceiver<api::traits::async, i2c::master> : private ll::i2c::Peripheral
@@ -702,6 +952,82 @@ private:
 };
 template<> class i2c::Transceiver<api::traits::async, i2c::slave> : private ll::i2c::Peripheral
 {
+public:
+#if 1 == XMCU_ISR_CONTEXT
+    void enable(const IRQ_priority& priority_a, void* p_context_a);
+#endif
+
+#if 0 == XMCU_ISR_CONTEXT
+    void enable(const IRQ_priority& priority_a);
+#endif
+    void disable();
+
+    // SMBus PEC: checked on master writes (last byte before STOP, a mismatch is reported as Error::pec in on_write),
+    // sent on master reads after read_length register bytes - the slave can't tell otherwise where the master stops
+    struct Pec
+    {
+        std::size_t read_length;
+    };
+
+    void register_map_start(std::span<std::uint8_t> map_a);
+    void register_map_start(std::span<std::uint8_t> map_a, const Pec& pec_a);
+    void register_map_stop();
+
+    // only I2C1 (EXTI 23) and I2C3 (EXTI 22) can wake the core up from Stop, both need HSI16 as the kernel clock
+    template<i2c::Id id_t> void wakeup_start()
+    {
+        constexpr std::uint32_t line = get_wakeup_line<id_t>();
+        static_assert(0x0u != line, "peripheral has no wake-up line");
+
+        assert(static_cast<std::uintptr_t>(id_t) == reinterpret_cast<std::uintptr_t>(this));
+        assert((true == i2c::clock::is_source_selected<id_t, oscillators::hsi16>()));
+        assert(false == xmcu::bit::flag::is(this->cr1, I2C_CR1_NOSTRETCH));
+
+        xmcu::bit::flag::set(&(this->cr1), I2C_CR1_WUPEN);
+        xmcu::bit::flag::set(&(EXTI->IMR1), line);
+    }
+    template<i2c::Id id_t> void wakeup_stop()
+    {
+        constexpr std::uint32_t line = get_wakeup_line<id_t>();
+        static_assert(0x0u != line, "peripheral has no wake-up line");
+
+        assert(static_cast<std::uintptr_t>(id_t) == reinterpret_cast<std::uintptr_t>(this));
+
+        xmcu::bit::flag::clear(&(EXTI->IMR1), line);
+        xmcu::bit::flag::clear(&(this->cr1), I2C_CR1_WUPEN);
+    }
+
+    struct handler : private xmcu::non_constructible
+    {
+        static void on_write(std::size_t address_a,
+                             std::size_t length_a,
+                             Error errors_a,
+                             Transceiver<api::traits::async, i2c::slave>* p_this_a);
+        static void on_read(std::size_t address_a,
+                            std::size_t length_a,
+                            Error errors_a,
+                            Transceiver<api::traits::async, i2c::slave>* p_this_a);
+    };
+
+private:
+    template<i2c::Id id_t> constexpr static std::uint32_t get_wakeup_line()
+    {
+#if defined XMCU_I2C1_PRESENT
+        if (i2c::Id::_1 == id_t)
+        {
+            return EXTI_IMR1_IM23;
+        }
+#endif
+#if defined XMCU_I2C3_PRESENT
+        if (i2c::Id::_3 == id_t)
+        {
+            return EXTI_IMR1_IM22;
+        }
+#endif
+        return 0x0u;
+    }
+
+    friend void i2c_slave_isr_handler(i2c::Transceiver<api::traits::async, i2c::slave>* p_handler_a);
 };
 
 template<> inline i2c::Transceiver<api::traits::sync, i2c::master>*
@@ -729,4 +1055,178 @@ i2c::Peripheral<i2c::slave>::view<i2c::Transceiver<api::traits::async, i2c::slav
     const std::uintptr_t base_address = reinterpret_cast<std::uintptr_t>(this);
     return reinterpret_cast<Transceiver<api::traits::async, i2c::slave>*>(base_address);
 }
+template<std::size_t register_count_t> class i2c::Device : private xmcu::non_copyable
+{
+public:
+    static_assert(register_count_t > 0u && register_count_t <= 256u, "register address has to fit in one byte");
+
+    Device(Transceiver<api::traits::sync, i2c::master>* p_transceiver_a, std::uint16_t address_a)
+        : p_transceiver(p_transceiver_a)
+        , address(address_a)
+    {
+    }
+
+    void set_volatile(std::uint8_t register_a, std::size_t count_a = 1u)
+    {
+        assert(register_a + count_a <= register_count_t);
+
+        for (std::size_t i = register_a; i < register_a + count_a; i++)
+        {
+            set(this->volatile_mask, i);
+        }
+    }
+
+    void write(std::uint8_t register_a, std::uint8_t value_a)
+    {
+        assert(register_a < register_count_t);
+
+        if (false == is(this->valid_mask, register_a) || value_a != this->shadow[register_a] || true == is(this->volatile_mask, register_a))
+        {
+            this->shadow[register_a] = value_a;
+            set(this->valid_mask, register_a);
+            set(this->dirty_mask, register_a);
+        }
+    }
+    void write(std::uint8_t register_a, std::span<const std::uint8_t> data_a)
+    {
+        for (std::size_t i = 0u; i < data_a.size(); i++)
+        {
+            this->write(static_cast<std::uint8_t>(register_a + i), data_a[i]);
+        }
+    }
+
+    std::pair<std::size_t, i2c::Error> flush()
+    {
+        std::size_t transmitted = 0u;
+        std::size_t i = 0u;
+
+        while (i < register_count_t)
+        {
+            if (false == is(this->dirty_mask, i))
+            {
+                i++;
+                continue;
+            }
+
+            std::size_t length = 0u;
+            std::uint8_t burst[max_burst_length + 1u];
+
+            burst[0] = static_cast<std::uint8_t>(i);
+            while (i + length < register_count_t && length < max_burst_length && true == is(this->dirty_mask, i + length))
+            {
+                burst[length + 1u] = this->shadow[i + length];
+                length++;
+            }
+
+            const std::pair<std::size_t, i2c::Error> ret = this->p_transceiver->transmit(this->address, { burst, length + 1u });
+
+            if (i2c::Error::none != ret.second)
+            {
+                return { transmitted, ret.second };
+            }
+
+            for (std::size_t j = i; j < i + length; j++)
+            {
+                clear(this->dirty_mask, j);
+            }
+
+            transmitted += length;
+            i += length;
+        }
+
+        return { transmitted, i2c::Error::none };
+    }
+
+    std::pair<std::size_t, i2c::Error> read(std::uint8_t register_a, std::span<std::uint8_t> data_a)
+    {
+        assert(register_a + data_a.size() <= register_count_t);
+
+        bool cached = true;
+        for (std::size_t i = register_a; i < register_a + data_a.size() && true == cached; i++)
+        {
+            cached = true == is(this->valid_mask, i) && false == is(this->volatile_mask, i);
+        }
+
+        if (false == cached)
+        {
+            const std::uint8_t pointer[] = { register_a };
+            std::pair<std::size_t, i2c::Error> ret = this->p_transceiver->transmit(this->address, pointer);
+
+            if (i2c::Error::none != ret.second)
+            {
+                return { 0u, ret.second };
+            }
+
+            ret = this->p_transceiver->receive(this->address, data_a);
+
+            for (std::size_t i = 0u; i < ret.first; i++)
+            {
+                // a pending write wins over the device value until it is flushed
+                if (false == is(this->dirty_mask, register_a + i))
+                {
+                    this->shadow[register_a + i] = data_a[i];
+                    set(this->valid_mask, register_a + i);
+                }
+            }
+
+            if (i2c::Error::none != ret.second)
+            {
+                return ret;
+            }
+        }
+
+        for (std::size_t i = 0u; i < data_a.size(); i++)
+        {
+            data_a[i] = this->shadow[register_a + i];
+        }
+
+        return { data_a.size(), i2c::Error::none };
+    }
+
+    void invalidate()
+    {
+        for (std::size_t i = 0u; i < mask_length; i++)
+        {
+            this->valid_mask[i] = this->dirty_mask[i];
+        }
+    }
+
+    [[nodiscard]] bool is_dirty() const
+    {
+        for (std::size_t i = 0u; i < mask_length; i++)
+        {
+            if (0x0u != this->dirty_mask[i])
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    constexpr static std::size_t mask_length = (register_count_t + 31u) / 32u;
+    constexpr static std::size_t max_burst_length = 32u;
+
+    static bool is(const std::uint32_t (&mask_a)[mask_length], std::size_t index_a)
+    {
+        return xmcu::bit::is(mask_a[index_a / 32u], index_a % 32u);
+    }
+    static void set(std::uint32_t (&mask_a)[mask_length], std::size_t index_a)
+    {
+        xmcu::bit::set(&(mask_a[index_a / 32u]), index_a % 32u);
+    }
+    static void clear(std::uint32_t (&mask_a)[mask_length], std::size_t index_a)
+    {
+        xmcu::bit::clear(&(mask_a[index_a / 32u]), index_a % 32u);
+    }
+
+    Transceiver<api::traits::sync, i2c::master>* p_transceiver;
+    std::uint16_t address;
+
+    std::uint8_t shadow[register_count_t] = {};
+    std::uint32_t valid_mask[mask_length] = {};
+    std::uint32_t dirty_mask[mask_length] = {};
+    std::uint32_t volatile_mask[mask_length] = {};
+};
 } // namespace soc::st::arm::m0::u0::rm0503::peripherals
\ No newline at end of file
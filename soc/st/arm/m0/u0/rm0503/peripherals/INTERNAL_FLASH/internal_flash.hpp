@@ -0,0 +1,153 @@
+#pragma once
+
+/*
+ *	Name: internal_flash.hpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+// std
+#include <cassert>
+#include <cstdint>
+
+// CMSIS
+#include <stm32u0xx.h>
+
+// xmcu
+#include <xmcu/bit.hpp>
+#include <xmcu/non_constructible.hpp>
+
+// soc
+#include <soc/st/arm/m0/u0/rm0503/peripherals/POWER/pwr.hpp>
+
+namespace soc::st::arm::m0::u0::rm0503::peripherals {
+namespace ll {
+struct internal_flash
+{
+};
+} // namespace ll
+
+struct internal_flash : private xmcu::non_constructible
+{
+    enum class Latency : std::uint32_t
+    {
+        _0 = 0x0u,
+        _1 = FLASH_ACR_LATENCY_0,
+        _2 = FLASH_ACR_LATENCY_1
+    };
+
+    struct prefetch : private xmcu::non_constructible
+    {
+        static void enable()
+        {
+            xmcu::bit::flag::set(&(FLASH->ACR), FLASH_ACR_PRFTEN);
+        }
+        static void disable()
+        {
+            xmcu::bit::flag::clear(&(FLASH->ACR), FLASH_ACR_PRFTEN);
+        }
+
+        [[nodiscard]] static bool is_enabled()
+        {
+            return xmcu::bit::flag::is(FLASH->ACR, FLASH_ACR_PRFTEN);
+        }
+    };
+    struct instruction_cache : private xmcu::non_constructible
+    {
+        static void enable()
+        {
+            xmcu::bit::flag::set(&(FLASH->ACR), FLASH_ACR_ICEN);
+        }
+        static void disable()
+        {
+            xmcu::bit::flag::clear(&(FLASH->ACR), FLASH_ACR_ICEN);
+        }
+        static void reset()
+        {
+            assert(false == is_enabled());
+
+            xmcu::bit::flag::set(&(FLASH->ACR), FLASH_ACR_ICRST);
+            xmcu::bit::flag::clear(&(FLASH->ACR), FLASH_ACR_ICRST);
+        }
+
+        [[nodiscard]] static bool is_enabled()
+        {
+            return xmcu::bit::flag::is(FLASH->ACR, FLASH_ACR_ICEN);
+        }
+    };
+
+    static void set_latency(Latency latency_a)
+    {
+        xmcu::bit::flag::set(&(FLASH->ACR), FLASH_ACR_LATENCY, static_cast<std::uint32_t>(latency_a));
+
+        // new value has to be read back before the clock changes
+        while (latency_a != get_latency()) continue;
+    }
+    [[nodiscard]] static Latency get_latency()
+    {
+        return static_cast<Latency>(xmcu::bit::flag::get(FLASH->ACR, FLASH_ACR_LATENCY));
+    }
+
+    [[nodiscard]] constexpr static Latency get_minimal_latency(std::uint32_t hclk_frequency_Hz_a, pwr::Voltage_scaling voltage_scaling_a)
+    {
+        if (pwr::Voltage_scaling::range_2 == voltage_scaling_a)
+        {
+            assert(hclk_frequency_Hz_a <= 16'000'000u);
+
+            return hclk_frequency_Hz_a <= 8'000'000u ? Latency::_0 : Latency::_1;
+        }
+
+        assert(hclk_frequency_Hz_a <= 56'000'000u);
+
+        if (hclk_frequency_Hz_a <= 24'000'000u)
+        {
+            return Latency::_0;
+        }
+        if (hclk_frequency_Hz_a <= 48'000'000u)
+        {
+            return Latency::_1;
+        }
+        return Latency::_2;
+    }
+    // without PWR clock the range can't be read, range 2 table is the safe one below 16 MHz
+    [[nodiscard]] static Latency get_minimal_latency(std::uint32_t hclk_frequency_Hz_a)
+    {
+        if (true == pwr::clock::is_enabled())
+        {
+            return get_minimal_latency(hclk_frequency_Hz_a, pwr::get_voltage_scaling());
+        }
+
+        return get_minimal_latency(hclk_frequency_Hz_a,
+                                   hclk_frequency_Hz_a > 16'000'000u ? pwr::Voltage_scaling::range_1 : pwr::Voltage_scaling::range_2);
+    }
+
+    // latency is raised before change_a() and lowered after it, prefetch is kept on only when wait states are used;
+    // ICEN is left as it is (set out of reset), instruction_cache is owned by the application
+    template<typename Function_t> static void set_hclk_frequency(std::uint32_t hclk_frequency_Hz_a, const Function_t& change_a)
+    {
+        const Latency latency = get_minimal_latency(hclk_frequency_Hz_a);
+
+        if (static_cast<std::uint32_t>(latency) > static_cast<std::uint32_t>(get_latency()))
+        {
+            set_latency(latency);
+            prefetch::enable();
+        }
+
+        change_a();
+
+        if (static_cast<std::uint32_t>(latency) < static_cast<std::uint32_t>(get_latency()))
+        {
+            set_latency(latency);
+        }
+        if (Latency::_0 == latency)
+        {
+            prefetch::disable();
+        }
+        else
+        {
+            prefetch::enable();
+        }
+    }
+};
+} // namespace soc::st::arm::m0::u0::rm0503::peripherals
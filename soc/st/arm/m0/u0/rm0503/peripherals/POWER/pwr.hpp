@@ -0,0 +1,113 @@
+#pragma once
+
+/*
+ *	Name: pwr.hpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+// std
+#include <cassert>
+#include <cstdint>
+
+// CMSIS
+#include <stm32u0xx.h>
+
+// xmcu
+#include <xmcu/bit.hpp>
+#include <xmcu/non_constructible.hpp>
+
+// soc
+#include <soc/st/arm/m0/u0/rm0503/clocks/peripheral_clock.hpp>
+
+namespace soc::st::arm::m0::u0::rm0503::peripherals {
+namespace ll {
+struct pwr
+{
+};
+} // namespace ll
+
+struct pwr : private xmcu::non_constructible
+{
+    enum class Stop_mode : std::uint32_t
+    {
+        _0 = 0x0u,
+        _1 = PWR_CR1_LPMS_0,
+        _2 = PWR_CR1_LPMS_1
+    };
+
+    enum class Voltage_scaling : std::uint32_t
+    {
+        range_1 = PWR_CR1_VOS_0,
+        range_2 = PWR_CR1_VOS_1
+    };
+
+    struct clock : private xmcu::non_constructible
+    {
+        static void enable()
+        {
+            clocks::peripheral_clock::acquire<clocks::peripheral_clock::Bus::apb1, RCC_APBENR1_PWREN>();
+        }
+        static void disable()
+        {
+            clocks::peripheral_clock::release<clocks::peripheral_clock::Bus::apb1, RCC_APBENR1_PWREN>();
+        }
+
+        [[nodiscard]] static bool is_enabled()
+        {
+            return xmcu::bit::flag::is(RCC->APBENR1, RCC_APBENR1_PWREN);
+        }
+    };
+
+    // RTC, LSE and RCC->BDCR are write protected out of reset
+    struct backup_domain : private xmcu::non_constructible
+    {
+        static void enable_write_access()
+        {
+            assert(true == clock::is_enabled());
+
+            xmcu::bit::flag::set(&(PWR->CR1), PWR_CR1_DBP);
+        }
+        static void disable_write_access()
+        {
+            assert(true == clock::is_enabled());
+
+            xmcu::bit::flag::clear(&(PWR->CR1), PWR_CR1_DBP);
+        }
+
+        [[nodiscard]] static bool is_write_access_enabled()
+        {
+            return xmcu::bit::flag::is(PWR->CR1, PWR_CR1_DBP);
+        }
+    };
+
+    // regulator settles before returning, SYSCLK above 16 MHz requires range 1
+    static void set_voltage_scaling(Voltage_scaling voltage_scaling_a)
+    {
+        assert(true == clock::is_enabled());
+
+        xmcu::bit::flag::set(&(PWR->CR1), PWR_CR1_VOS, static_cast<std::uint32_t>(voltage_scaling_a));
+        while (true == xmcu::bit::flag::is(PWR->SR2, PWR_SR2_VOSF)) continue;
+    }
+    [[nodiscard]] static Voltage_scaling get_voltage_scaling()
+    {
+        assert(true == clock::is_enabled());
+
+        return static_cast<Voltage_scaling>(xmcu::bit::flag::get(PWR->CR1, PWR_CR1_VOS));
+    }
+
+    static void stop(Stop_mode mode_a)
+    {
+        assert(true == clock::is_enabled());
+
+        xmcu::bit::flag::set(&(PWR->CR1), PWR_CR1_LPMS, static_cast<std::uint32_t>(mode_a));
+        xmcu::bit::flag::set(&(SCB->SCR), SCB_SCR_SLEEPDEEP_Msk);
+
+        __DSB();
+        __WFI();
+
+        xmcu::bit::flag::clear(&(SCB->SCR), SCB_SCR_SLEEPDEEP_Msk);
+    }
+};
+} // namespace soc::st::arm::m0::u0::rm0503::peripherals
@@ -18,6 +18,8 @@ using namespace soc::st::arm::m0::u0::rm0503::oscillators;
 using namespace soc::st::arm::m0::u0::rm0503::peripherals;
 
 constexpr std::uint32_t clock_prescaler_lut[] = { 1u, 2u, 4u, 6u, 8u, 10u, 12u, 16u, 32u, 64u, 128u, 256u };
+// upper bound for the last frames to leave the shifter before a clock change, the transfer is aborted after it
+constexpr std::chrono::milliseconds frequency_scaling_timeout = std::chrono::milliseconds(50);
 
 IRQn_Type select_irq(std::uint32_t base_address_a)
 {
@@ -45,15 +47,15 @@ IRQn_Type select_irq(std::uint32_t base_address_a)
     return static_cast<IRQn_Type>(0xFFFFFFFF);
 }
 
-template<usart::Id id_t> std::uint32_t get_usart_source_freq_Hz()
+template<usart::Id id_t> std::uint32_t get_usart_source_freq_Hz(std::uint32_t sysclk_Hz_a, std::uint32_t pclk_Hz_a)
 {
     if (true == usart::clock::is_source_selected<id_t, sysclk>())
     {
-        return sysclk::get_frequency_Hz();
+        return sysclk_Hz_a;
     }
     if (true == usart::clock::is_source_selected<id_t, pclk>())
     {
-        return pclk::get_frequency_Hz();
+        return pclk_Hz_a;
     }
     if (true == usart::clock::is_source_selected<id_t, lse>())
     {
@@ -67,30 +69,30 @@ template<usart::Id id_t> std::uint32_t get_usart_source_freq_Hz()
     return 0;
 }
 
-std::uint32_t get_source_freq_Hz(usart::Id id_a)
+std::uint32_t get_source_freq_Hz(usart::Id id_a, std::uint32_t sysclk_Hz_a, std::uint32_t pclk_Hz_a)
 {
 #if defined XMCU_USART1_PRESENT
     if (usart::Id::_1 == id_a)
     {
-        return get_usart_source_freq_Hz<usart::_1>();
+        return get_usart_source_freq_Hz<usart::_1>(sysclk_Hz_a, pclk_Hz_a);
     }
 #endif
 #if defined XMCU_USART2_PRESENT
     if (usart::Id::_2 == id_a)
     {
-        return get_usart_source_freq_Hz<usart::_2>();
+        return get_usart_source_freq_Hz<usart::_2>(sysclk_Hz_a, pclk_Hz_a);
     }
 #endif
 #if defined XMCU_USART3_PRESENT
     if (usart::Id::_3 == id_a)
     {
-        return get_usart_source_freq_Hz<usart::_3>();
+        return get_usart_source_freq_Hz<usart::_3>(sysclk_Hz_a, pclk_Hz_a);
     }
 #endif
 #if defined XMCU_USART4_PRESENT
     if (usart::Id::_4 == id_a)
     {
-        return get_usart_source_freq_Hz<usart::_4>();
+        return get_usart_source_freq_Hz<usart::_4>(sysclk_Hz_a, pclk_Hz_a);
     }
 #endif
 
@@ -200,7 +202,7 @@ void usart::Peripheral::set_descriptor(const Descriptor& descriptor_a)
     if (0x0u == (0xFFFFFFFFu & descriptor_a.baudrate))
     {
         const std::uint32_t baudrate = static_cast<std::uint32_t>((static_cast<std::uint64_t>(descriptor_a.baudrate) >> 32u));
-        const std::uint32_t clk_freq_Hz = get_source_freq_Hz(this->get_id());
+        const std::uint32_t clk_freq_Hz = get_source_freq_Hz(this->get_id(), sysclk::get_frequency_Hz(), pclk::get_frequency_Hz());
         assert(0x0u != baudrate);
         switch (descriptor_a.oversampling)
         {
@@ -260,6 +262,70 @@ bool usart::Peripheral::disable(std::chrono::milliseconds timeout_a)
     return bit::wait_for::all_cleared(this->isr, ll::usart::ISR::reack | ll::usart::ISR::teack, timeout_a);
 }
 
+// UE is dropped after the last frame left the shifter (or frequency_scaling_timeout passed, aborting the transfer),
+// TE/RE stay set and mark the peripheral to be restarted
+void usart::Peripheral::on_frequency_scaling(clocks::frequency_scaling::Event event_a,
+                                             const clocks::frequency_scaling::Frequencies& from_a,
+                                             const clocks::frequency_scaling::Frequencies& to_a,
+                                             void* p_context_a)
+{
+    usart::Peripheral* p_this = static_cast<usart::Peripheral*>(p_context_a);
+
+    const std::uint32_t from_Hz = get_source_freq_Hz(p_this->get_id(), from_a.sysclk_Hz, from_a.pclk_Hz);
+    const std::uint32_t to_Hz = get_source_freq_Hz(p_this->get_id(), to_a.sysclk_Hz, to_a.pclk_Hz);
+
+    if (from_Hz == to_Hz)
+    {
+        return;
+    }
+
+    switch (event_a)
+    {
+        case clocks::frequency_scaling::Event::prepare: {
+            if (true == bit::flag::is(p_this->cr1, ll::usart::CR1::ue))
+            {
+                const std::chrono::steady_clock::time_point end_time_point =
+                    std::chrono::steady_clock::now() + frequency_scaling_timeout;
+
+                if (true == bit::flag::is(p_this->cr1, ll::usart::CR1::te))
+                {
+                    while (false == bit::flag::is(p_this->isr, ll::usart::ISR::tc) && std::chrono::steady_clock::now() < end_time_point)
+                        continue;
+                }
+                while (true == bit::flag::is(p_this->isr, ll::usart::ISR::busy) && std::chrono::steady_clock::now() < end_time_point)
+                    continue;
+
+                bit::flag::clear(&(p_this->cr1), ll::usart::CR1::ue);
+            }
+        }
+        break;
+
+        case clocks::frequency_scaling::Event::complete: {
+            if (true == bit::flag::is(p_this->cr1, ll::usart::CR1::ue) ||
+                0x0u == static_cast<std::uint32_t>(static_cast<ll::usart::BRR::Data>(p_this->brr)))
+            {
+                return;
+            }
+
+            const bool over8 = bit::flag::is(p_this->cr1, ll::usart::CR1::over8);
+            const std::uint32_t brr = static_cast<std::uint32_t>(static_cast<ll::usart::BRR::Data>(p_this->brr));
+
+            // with oversampling by 8 BRR[2:0] holds USARTDIV[3:1]
+            std::uint32_t div = true == over8 ? ((brr & 0xFFF0u) | ((brr & 0x7u) << 1u)) : brr;
+            div = static_cast<std::uint32_t>((static_cast<std::uint64_t>(div) * to_Hz + from_Hz / 2u) / from_Hz);
+            assert(div >= 0x10u && div <= 0xFFFFu);
+
+            p_this->brr = static_cast<std::uint16_t>(true == over8 ? ((div & 0xFFF0u) | ((div & 0xFu) >> 1u)) : div);
+
+            if (true == bit::is_any(p_this->cr1, ll::usart::CR1::te | ll::usart::CR1::re))
+            {
+                bit::flag::set(&(p_this->cr1), ll::usart::CR1::ue);
+            }
+        }
+        break;
+    }
+}
+
 #if 1 == XMCU_ISR_CONTEXT
 void usart::Transceiver<api::traits::async>::enable(const IRQ_priority& priority_a, void* p_context_a)
 #endif
@@ -23,6 +23,7 @@
 // soc
 #include <soc/st/arm/IRQ_priority.hpp>
 #include <soc/st/arm/api.hpp>
+#include <soc/st/arm/m0/u0/rm0503/clocks/frequency_scaling.hpp>
 #include <soc/st/arm/m0/u0/rm0503/clocks/pclk.hpp>
 #include <soc/st/arm/m0/u0/rm0503/clocks/sysclk.hpp>
 #include <soc/st/arm/m0/u0/rm0503/oscillators/hsi16.hpp>
@@ -281,6 +282,12 @@ struct usart : public usart_base
             return static_cast<Id>(reinterpret_cast<std::uintptr_t>(this));
         }
 
+        // clocks::frequency_scaling handler, p_context_a: usart::Peripheral*
+        static void on_frequency_scaling(clocks::frequency_scaling::Event event_a,
+                                         const clocks::frequency_scaling::Frequencies& from_a,
+                                         const clocks::frequency_scaling::Frequencies& to_a,
+                                         void* p_context_a);
+
         template<typename Type_t> Type_t* view() const = delete;
     };
 
@@ -11,7 +11,11 @@
 #include <cassert>
 #include <tuple>
 
+// xmcu
+#include <xmcu/Scoped_guard.hpp>
+
 // soc/st
+#include <soc/st/arm/nvic.hpp>
 #include <soc/st/arm/systick.hpp>
 
 namespace {
@@ -22,9 +26,21 @@ using namespace soc::st::arm;
 void* p_context = nullptr;
 #endif
 
+volatile std::uint32_t reload_count = 0x0u;
+
+// cycles of the periods completed so far, each period is accounted with the LOAD it actually ran with
+volatile std::uint32_t cycles = 0x0u;
+volatile std::uint32_t period = 0x0u;  // length of the running period
+volatile std::uint32_t latched = 0x0u; // length of the period started by the next (or pending) reload
+
 extern "C" {
 void SysTick_Handler()
 {
+    cycles = cycles + period;
+    period = latched;
+    latched = SysTick->LOAD + 1u;
+    reload_count = reload_count + 1u;
+
 #if 1 == XMCU_ISR_CONTEXT
     systick::Tick_counter<api::traits::async>::isr::on_reload(
         reinterpret_cast<systick::Tick_counter<api::traits::async>*>(SysTick_BASE), SysTick->VAL, p_context);
@@ -70,9 +86,53 @@ void systick::Tick_counter<api::traits::async>::start(const IRQ_priority& priori
 #endif
     NVIC_SetPriority(SysTick_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), priority_a.preempt_priority, priority_a.sub_priority));
 
+    period = this->load + 1u;
+    latched = this->load + 1u;
+
     bit::flag::set(&(this->ctrl), SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk);
 }
 
+void systick::Tick_counter<api::traits::async>::set_reload(std::uint32_t reload_a)
+{
+    assert(reload_a > 0 && reload_a <= 0xFFF'FFFu);
+
+    Scoped_guard<nvic> guard;
+
+    // counter already wrapped with the old LOAD and the reload is pending: only the period after it gets the new one
+    if (false == bit::flag::is(SCB->ICSR, SCB_ICSR_PENDSTSET_Msk))
+    {
+        latched = reload_a + 1u;
+    }
+
+    this->load = reload_a;
+}
+
+std::uint32_t systick::Tick_counter<api::traits::async>::get_timestamp() const
+{
+    std::uint32_t reloads = 0x0u;
+    std::uint32_t completed = 0x0u;
+    std::uint32_t running = 0x0u;
+    std::uint32_t value = 0x0u;
+
+    do
+    {
+        reloads = reload_count;
+        completed = cycles;
+        running = period;
+        value = this->val;
+    } while (reloads != reload_count);
+
+    // counter wrapped but the reload was not serviced yet (caller runs above systick priority)
+    if (true == bit::flag::is(SCB->ICSR, SCB_ICSR_PENDSTSET_Msk))
+    {
+        completed += running;
+        running = latched;
+        value = this->val;
+    }
+
+    return completed + (running - 1u - value);
+}
+
 void systick::Tick_counter<api::traits::async>::stop()
 {
     bit::flag::clear(&(this->ctrl), SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk);
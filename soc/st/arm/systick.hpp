@@ -157,11 +157,17 @@ public:
 #endif
     void stop();
 
+    // takes effect with the next reload, get_timestamp stays continuous
+    void set_reload(std::uint32_t reload_a);
+
     bool is_started() const
     {
         return xmcu::bit::flag::is(this->ctrl, SysTick_CTRL_ENABLE_Msk);
     }
 
+    // free running count of systick input clock cycles, wraps at 2^32
+    [[nodiscard]] std::uint32_t get_timestamp() const;
+
     struct isr : private non_constructible
     {
 #if 1 == XMCU_ISR_CONTEXT
@@ -0,0 +1,22 @@
+#pragma once
+
+/*
+ *	Name: peripheral_clock.hpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+// clang-format off
+// xmcu
+#include <xmcu/macros.hpp>
+// soc
+#include DECORATE_INCLUDE_PATH(soc/XMCU_SOC_VENDOR/XMCU_SOC_ARCH/XMCU_SOC_ARCH_CORE_FAMILY/XMCU_SOC_VENDOR_FAMILY/XMCU_SOC_VENDOR_FAMILY_RM/clocks/peripheral_clock.hpp)
+// clang-format on
+
+namespace xmcu::hal::clocks {
+#if !defined XMCU_LL_ONLY
+using peripheral_clock =
+    soc::XMCU_SOC_VENDOR::XMCU_SOC_ARCH::XMCU_SOC_ARCH_CORE_FAMILY::XMCU_SOC_VENDOR_FAMILY::XMCU_SOC_VENDOR_FAMILY_RM::clocks::peripheral_clock;
+#endif
+} // namespace xmcu::hal::clocks
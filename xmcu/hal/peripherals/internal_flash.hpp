@@ -0,0 +1,30 @@
+#pragma once
+
+/*
+ *	Name: internal_flash.hpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+// clang-format off
+// xmcu
+#include <xmcu/macros.hpp>
+// soc
+#include DECORATE_INCLUDE_PATH(soc/XMCU_SOC_VENDOR/XMCU_SOC_ARCH/XMCU_SOC_ARCH_CORE_FAMILY/XMCU_SOC_VENDOR_FAMILY/XMCU_SOC_VENDOR_FAMILY_RM/peripherals/INTERNAL_FLASH/internal_flash.hpp)
+// clang-format on
+
+namespace xmcu::hal::peripherals {
+#if !defined XMCU_LL_ONLY
+using internal_flash = soc::XMCU_SOC_VENDOR::XMCU_SOC_ARCH::XMCU_SOC_ARCH_CORE_FAMILY::XMCU_SOC_VENDOR_FAMILY::XMCU_SOC_VENDOR_FAMILY_RM::
+    peripherals::internal_flash;
+#endif
+
+#if defined XMCU_LL_ONLY
+inline
+#endif
+    namespace ll {
+using internal_flash = soc::XMCU_SOC_VENDOR::XMCU_SOC_ARCH::XMCU_SOC_ARCH_CORE_FAMILY::XMCU_SOC_VENDOR_FAMILY::XMCU_SOC_VENDOR_FAMILY_RM::
+    peripherals::ll::internal_flash;
+} // namespace ll
+} // namespace xmcu::hal::peripherals
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+/*
+ *	Name: pwr.hpp
+ *
+ *  Copyright (c) Mateusz Semegen and contributors. All rights reserved.
+ *  Licensed under the MIT license. See LICENSE file in the project root for details.
+ */
+
+// clang-format off
+// xmcu
+#include <xmcu/macros.hpp>
+// soc
+#include DECORATE_INCLUDE_PATH(soc/XMCU_SOC_VENDOR/XMCU_SOC_ARCH/XMCU_SOC_ARCH_CORE_FAMILY/XMCU_SOC_VENDOR_FAMILY/XMCU_SOC_VENDOR_FAMILY_RM/peripherals/POWER/pwr.hpp)
+// clang-format on
+
+namespace xmcu::hal::peripherals {
+#if !defined XMCU_LL_ONLY
+using pwr =
+    soc::XMCU_SOC_VENDOR::XMCU_SOC_ARCH::XMCU_SOC_ARCH_CORE_FAMILY::XMCU_SOC_VENDOR_FAMILY::XMCU_SOC_VENDOR_FAMILY_RM::peripherals::pwr;
+#endif
+
+#if defined XMCU_LL_ONLY
+inline
+#endif
+    namespace ll {
+using pwr =
+    soc::XMCU_SOC_VENDOR::XMCU_SOC_ARCH::XMCU_SOC_ARCH_CORE_FAMILY::XMCU_SOC_VENDOR_FAMILY::XMCU_SOC_VENDOR_FAMILY_RM::peripherals::ll::pwr;
+} // namespace ll
+} // namespace xmcu::hal::peripherals
\ No newline at end of file
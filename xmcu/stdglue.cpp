@@ -16,8 +16,10 @@
 
 // soc
 #include <soc/st/arm/Systick.hpp>
+#include <soc/st/arm/nvic.hpp>
 
 // xmcu
+#include <xmcu/bit.hpp>
 #include <xmcu/stdglue.hpp>
 
 namespace {
@@ -29,6 +31,9 @@ volatile std::uint64_t systick_count = 0x0u;
 systick::Tick_counter<api::traits::async>* p_timer = nullptr;
 std::uint64_t prescaler = 0u;
 std::uint32_t current_val = 0u;
+// set by rescale, taken over on the reload that starts the first period with the new LOAD (0 - none pending)
+volatile std::uint64_t next_prescaler = 0u;
+volatile std::uint32_t next_prescaler_reloads = 0u;
 constexpr std::uint64_t parts_in_millisecond = 1000000ull;
 
 #if 0 == XMCU_NOSTDLIB
@@ -76,6 +81,16 @@ void systick::Tick_counter
 <api::traits::async>::isr::on_reload(systick::Tick_counter<api::traits::async>* p_systick_a, std::uint32_t value_a)
 #endif
 {
+    if (0u != next_prescaler_reloads)
+    {
+        next_prescaler_reloads = next_prescaler_reloads - 1u;
+
+        if (0u == next_prescaler_reloads)
+        {
+            prescaler = next_prescaler;
+        }
+    }
+
     current_val = value_a;
     systick_count = systick_count + 1u;
 #if 1 == XMCU_NOSTDLIB
@@ -110,6 +125,22 @@ void stdglue::steady_clock::set_source(systick::Tick_counter<api::traits::async>
 {
     p_timer = p_clock_a;
     prescaler = (parts_in_millisecond / (p_timer->get_descriptor().reload + 1u));
+    next_prescaler_reloads = 0u;
+}
+
+void stdglue::steady_clock::rescale(std::uint32_t from_Hz_a, std::uint32_t to_Hz_a)
+{
+    assert(nullptr != p_timer);
+
+    const std::uint32_t reload =
+        static_cast<std::uint32_t>((static_cast<std::uint64_t>(p_timer->get_descriptor().reload) + 1u) * to_Hz_a / from_Hz_a) - 1u;
+
+    // prescaler follows LOAD instead of changing under the running period: high_ticks and current_val were captured with the old
+    // one, switching it here would make now() jump. A reload already pending still ends a period of the old LOAD
+    Scoped_guard<nvic> guard;
+    next_prescaler_reloads = true == bit::flag::is(SCB->ICSR, SCB_ICSR_PENDSTSET_Msk) ? 2u : 1u;
+    next_prescaler = (parts_in_millisecond / (reload + 1u));
+    p_timer->set_reload(reload);
 }
 } // namespace xmcu
 
@@ -31,6 +31,20 @@ struct stdglue : private xmcu::non_constructible
     struct steady_clock : private non_constructible
     {
         static void set_source(soc::st::arm::systick::Tick_counter<soc::st::arm::api::traits::async>* p_clock_a);
+
+        // keeps the tick period after the systick input clock changed from from_Hz_a to to_Hz_a
+        static void rescale(std::uint32_t from_Hz_a, std::uint32_t to_Hz_a);
+
+        // clocks::frequency_scaling handler (systick runs from HCLK), register with
+        // frequency_scaling::register_handler(xmcu::stdglue::steady_clock::on_frequency_scaling, nullptr)
+        template<typename Event_t, typename Frequencies_t>
+        static void on_frequency_scaling(Event_t event_a, const Frequencies_t& from_a, const Frequencies_t& to_a, void*)
+        {
+            if (Event_t::complete == event_a && 0u != from_a.hclk_Hz && from_a.hclk_Hz != to_a.hclk_Hz)
+            {
+                rescale(from_a.hclk_Hz, to_a.hclk_Hz);
+            }
+        }
     };
 };
 } // namespace xmcu
\ No newline at end of file